@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/adaptive_int.hpp>
+#include <projgeom/bigint.hpp>
+#include <projgeom/pg_object.hpp>
+
+using fun::AdaptiveInt;
+using fun::BigInt;
+
+namespace {
+
+constexpr std::size_t kCount = 1024;
+
+template <typename T>
+auto make_coords(int64_t bound) -> std::vector<std::array<T, 3>> {
+  std::mt19937_64 gen{2023};
+  std::uniform_int_distribution<int64_t> dist{-bound, bound};
+  std::vector<std::array<T, 3>> res;
+  res.reserve(kCount);
+  for (std::size_t i = 0; i != kCount; ++i) {
+    res.push_back({T(dist(gen)), T(dist(gen)), T(dist(gen))});
+  }
+  return res;
+}
+
+template <typename T> void bench_cross(benchmark::State &state) {
+  const auto coords = make_coords<T>(state.range(0));
+  for (auto _ : state) {
+    for (std::size_t i = 0; i + 1 < coords.size(); ++i) {
+      auto res = ::cross(coords[i], coords[i + 1]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * (kCount - 1));
+}
+
+// int64 cross product with overflow detection but no widening: isolates
+// the cost of the overflow checks themselves.
+void bench_cross_checked(benchmark::State &state) {
+  const auto coords = make_coords<int64_t>(state.range(0));
+  for (auto _ : state) {
+    bool overflow = false;
+    for (std::size_t i = 0; i + 1 < coords.size(); ++i) {
+      const auto &a = coords[i];
+      const auto &b = coords[i + 1];
+      std::array<int64_t, 3> res;
+      for (int k = 0; k != 3; ++k) {
+        const int j = (k + 1) % 3;
+        const int l = (k + 2) % 3;
+        int64_t s;
+        int64_t t;
+        overflow |= fun::detail::mul_overflow(a[j], b[l], &s);
+        overflow |= fun::detail::mul_overflow(a[l], b[j], &t);
+        overflow |= fun::detail::sub_overflow(s, t, &res[k]);
+      }
+      benchmark::DoNotOptimize(res);
+    }
+    benchmark::DoNotOptimize(overflow);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * (kCount - 1));
+}
+
+} // namespace
+
+// Inputs bounded by 2^20 never overflow: this measures the cost of the
+// overflow checks on the fast path against unchecked int64.
+BENCHMARK(bench_cross<int64_t>)->Name("cross/int64_unchecked")->Arg(1 << 20);
+BENCHMARK(bench_cross_checked)->Name("cross/int64_checked")->Arg(1 << 20);
+BENCHMARK(bench_cross<AdaptiveInt>)->Name("cross/adaptive")->Arg(1 << 20);
+BENCHMARK(bench_cross<BigInt>)->Name("cross/bigint")->Arg(1 << 20);
+// Inputs near 2^40 overflow int64 in every product and take the __int128
+// path (BigInt without __int128).
+BENCHMARK(bench_cross<AdaptiveInt>)
+    ->Name("cross/adaptive_widened")
+    ->Arg(int64_t(1) << 40);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,108 @@
+#pragma once
+
+/** @file bench/bench_generators.hpp
+ *  Seeded input generators shared by the benchmarks.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/pg_plane.hpp>
+
+namespace bench {
+
+/** Seed used by every generator, so that runs are comparable */
+constexpr uint64_t kSeed = 2023;
+
+/** Coordinate bound: keeps harm_conj and orthocenter within int64 */
+constexpr int64_t kBound = 1 << 6;
+
+/** Coordinate bound for involution, whose degree is much higher */
+constexpr int64_t kSmallBound = 1 << 4;
+
+/** Coordinate bound for a reflection followed by an altitude */
+constexpr int64_t kTinyBound = 1 << 2;
+
+/**
+ * @brief Random points with coordinates in [-bound, bound]
+ *
+ * @tparam P
+ * @param[in] n
+ * @param[in] seed
+ * @param[in] bound
+ * @return std::vector<P>
+ */
+template <class P>
+auto random_points(std::size_t n, uint64_t seed = kSeed,
+                   int64_t bound = kBound) -> std::vector<P> {
+  using T = typename P::value_type;
+  std::mt19937_64 gen{seed};
+  std::uniform_int_distribution<int64_t> dist{-bound, bound};
+  std::vector<P> res;
+  res.reserve(n);
+  while (res.size() != n) {
+    const auto x = dist(gen);
+    const auto y = dist(gen);
+    const auto z = dist(gen);
+    if (x == 0 && y == 0 && z == 0) {
+      continue;
+    }
+    res.push_back(P({T(x), T(y), T(z)}));
+  }
+  return res;
+}
+
+/**
+ * @brief Random non-degenerate triangles
+ *
+ * @tparam P
+ * @param[in] n
+ * @param[in] seed
+ * @return std::vector<std::array<P, 3>>
+ */
+template <class P>
+auto random_triangles(std::size_t n, uint64_t seed = kSeed)
+    -> std::vector<std::array<P, 3>> {
+  const auto pts = random_points<P>(3 * n + 64, seed);
+  std::vector<std::array<P, 3>> res;
+  res.reserve(n);
+  for (std::size_t i = 0; res.size() != n && i + 2 < pts.size(); i += 3) {
+    if (!fun::coincident(pts[i], pts[i + 1], pts[i + 2])) {
+      res.push_back({pts[i], pts[i + 1], pts[i + 2]});
+    }
+  }
+  return res;
+}
+
+/**
+ * @brief Random triples of distinct collinear points (inputs of harm_conj)
+ *
+ * @tparam P
+ * @param[in] n
+ * @param[in] seed
+ * @return std::vector<std::array<P, 3>>
+ */
+template <class P>
+auto random_collinear(std::size_t n, uint64_t seed = kSeed)
+    -> std::vector<std::array<P, 3>> {
+  using T = typename P::value_type;
+  const auto pts = random_points<P>(2 * n + 64, seed);
+  std::mt19937_64 gen{seed + 1};
+  std::uniform_int_distribution<int64_t> dist{1, 16};
+  std::vector<std::array<P, 3>> res;
+  res.reserve(n);
+  for (std::size_t i = 0; res.size() != n && i + 1 < pts.size(); i += 2) {
+    const auto &a = pts[i];
+    const auto &b = pts[i + 1];
+    if (a == b) {
+      continue;
+    }
+    res.push_back({a, b, P::plucker(T(dist(gen)), a, T(dist(gen)), b)});
+  }
+  return res;
+}
+
+} // namespace bench
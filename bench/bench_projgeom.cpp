@@ -0,0 +1,510 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <projgeom/adaptive_int.hpp>
+#include <projgeom/arrangement.hpp>
+#include <projgeom/ck_plane.hpp>
+#include <projgeom/ck_runtime.hpp>
+#include <projgeom/collinear.hpp>
+#include <projgeom/construction.hpp>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/homography.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/myck_object.hpp>
+#include <projgeom/oriented_object.hpp>
+#include <projgeom/persp_object.hpp>
+#include <projgeom/pg_expr.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_plane.hpp>
+#include <projgeom/rational_trig.hpp>
+#include <projgeom/triangle_batch.hpp>
+
+#include "bench_generators.hpp"
+
+namespace {
+
+constexpr std::size_t kCount = 1024;
+
+// Micro benchmarks: one primitive over kCount seeded inputs.
+
+template <class P> void bench_circ(benchmark::State &state) {
+  const auto pts = bench::random_points<P>(kCount + 1);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != kCount; ++i) {
+      auto res = pts[i].circ(pts[i + 1]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+template <class P> void bench_incident(benchmark::State &state) {
+  using L = typename P::Dual;
+  const auto pts = bench::random_points<P>(kCount);
+  const auto lns = bench::random_points<L>(kCount, bench::kSeed + 1);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != kCount; ++i) {
+      auto res = pts[i].incident(lns[i]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+template <class P> void bench_perp(benchmark::State &state) {
+  const auto pts = bench::random_points<P>(kCount);
+  for (auto _ : state) {
+    for (const auto &p : pts) {
+      auto res = p.perp();
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+template <class P> void bench_harm_conj(benchmark::State &state) {
+  using T = typename P::value_type;
+  const auto triples = bench::random_collinear<P>(kCount);
+  for (auto _ : state) {
+    for (const auto &[a, b, c] : triples) {
+      auto res = fun::harm_conj<T>(a, b, c);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+template <class P> void bench_involution(benchmark::State &state) {
+  using T = typename P::value_type;
+  using L = typename P::Dual;
+  const auto origins =
+      bench::random_points<P>(kCount, bench::kSeed, bench::kSmallBound);
+  const auto mirrors =
+      bench::random_points<L>(kCount, bench::kSeed + 1, bench::kSmallBound);
+  const auto pts =
+      bench::random_points<P>(kCount, bench::kSeed + 2, bench::kSmallBound);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != kCount; ++i) {
+      auto res = fun::involution<T>(origins[i], mirrors[i], pts[i]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+template <class P> void bench_involution_matrix(benchmark::State &state) {
+  using L = typename P::Dual;
+  const auto origins =
+      bench::random_points<P>(kCount, bench::kSeed, bench::kSmallBound);
+  const auto mirrors =
+      bench::random_points<L>(kCount, bench::kSeed + 1, bench::kSmallBound);
+  const auto pts =
+      bench::random_points<P>(kCount, bench::kSeed + 2, bench::kSmallBound);
+  const auto inv = fun::make_involution(origins[0], mirrors[0]);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != kCount; ++i) {
+      auto res = inv.map_point(pts[i]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+template <class P> void bench_orthocenter(benchmark::State &state) {
+  const auto tris = bench::random_triangles<P>(kCount);
+  for (auto _ : state) {
+    for (const auto &tri : tris) {
+      auto res = fun::orthocenter(tri);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+// Macro benchmarks: whole theorem checks. Their polynomial degree exceeds
+// int64 even for small inputs, so they run on the __int128 instantiation
+// (AdaptiveInt where the compiler has no __int128).
+#if PROJGEOM_HAS_INT128
+using WideInt = __int128;
+#else
+using WideInt = fun::AdaptiveInt;
+#endif
+
+template <class P> void bench_check_pappus(benchmark::State &state) {
+  const auto co1 = bench::random_collinear<P>(kCount);
+  const auto co2 = bench::random_collinear<P>(kCount, bench::kSeed + 1);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != kCount; ++i) {
+      auto res = fun::check_pappus(co1[i], co2[i]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+// Same check through the expression templates of pg_expr.hpp.
+template <class P> void bench_check_pappus_fused(benchmark::State &state) {
+  const auto co1 = bench::random_collinear<P>(kCount);
+  const auto co2 = bench::random_collinear<P>(kCount, bench::kSeed + 1);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != kCount; ++i) {
+      auto res = fun::expr::check_pappus(co1[i], co2[i]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+template <class P> void bench_check_desargue(benchmark::State &state) {
+  const auto tri1 = bench::random_triangles<P>(kCount);
+  const auto tri2 = bench::random_triangles<P>(kCount, bench::kSeed + 1);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != kCount; ++i) {
+      auto res = fun::check_desargue(tri1[i], tri2[i]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+// Half-plane classification of state.range(0) points against one line.
+
+void bench_side(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = bench::random_points<OrientedPoint>(n);
+  const auto ln = OrientedLine({3, -5, 7});
+  for (auto _ : state) {
+    std::size_t cnt = 0;
+    for (const auto &p : pts) {
+      cnt += std::size_t(p.side(ln) > 0);
+    }
+    benchmark::DoNotOptimize(cnt);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+void bench_side_of(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = OrientedPointArray(bench::random_points<OrientedPoint>(n));
+  const auto ln = OrientedLine({3, -5, 7});
+  for (auto _ : state) {
+    auto res = fun::side_of(ln, pts);
+    benchmark::DoNotOptimize(res.count_pos());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+// Arrangement of state.range(0) lines: pairwise meets + deduplication.
+
+void bench_arrangement_naive(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto lns = bench::random_points<PgLine>(n);
+  for (auto _ : state) {
+    std::vector<PgPoint> pts;
+    for (std::size_t i = 0; i != n; ++i) {
+      for (std::size_t j = i + 1; j != n; ++j) {
+        const auto p = lns[i].circ(lns[j]);
+        if (std::find(pts.begin(), pts.end(), p) == pts.end()) {
+          pts.push_back(p);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(pts.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n * n / 2));
+}
+
+void bench_arrangement(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto lns = bench::random_points<PgLine>(n);
+  for (auto _ : state) {
+    auto res = fun::arrangement(lns);
+    benchmark::DoNotOptimize(res.lines.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n * n / 2));
+}
+
+// Degeneracy detection: all collinear subsets of state.range(0) points.
+
+void bench_collinear_naive(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = bench::random_points<PgPoint>(n);
+  for (auto _ : state) {
+    std::size_t cnt = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+      for (std::size_t j = i + 1; j != n; ++j) {
+        for (std::size_t k = j + 1; k != n; ++k) {
+          cnt += std::size_t(fun::coincident(pts[i], pts[j], pts[k]));
+        }
+      }
+    }
+    benchmark::DoNotOptimize(cnt);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+void bench_collinear_groups(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = bench::random_points<PgPoint>(n);
+  for (auto _ : state) {
+    auto res = fun::collinear_groups(pts);
+    benchmark::DoNotOptimize(res.members.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+// One transformation applied to state.range(0) points.
+
+const auto bench_homography =
+    fun::Homography<int64_t>{{{{3, -1, 4}, {1, 5, -9}, {2, 6, 5}}}};
+
+void bench_map_point(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = bench::random_points<PgPoint>(n);
+  std::vector<PgPoint> res(n, PgPoint({0, 0, 1}));
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != n; ++i) {
+      res[i] = bench_homography.map_point(pts[i]);
+    }
+    benchmark::DoNotOptimize(res.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+void bench_map_points(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = PgPointArray(bench::random_points<PgPoint>(n));
+  auto res = PgPointArray(n);
+  for (auto _ : state) {
+    bench_homography.map_points(pts, res);
+    benchmark::DoNotOptimize(res.columns()[0]);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+// Polars of state.range(0) points: compile-time conic vs runtime conic.
+
+template <class Geom> void bench_perp_batch(benchmark::State &state) {
+  using P = typename Geom::template Point<int64_t>;
+  const auto n = std::size_t(state.range(0));
+  const auto pts = PgArray<P>(bench::random_points<P>(n));
+  for (auto _ : state) {
+    auto res = fun::perp(pts);
+    benchmark::DoNotOptimize(res.columns()[0]);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template <class Geom> void bench_perp_runtime(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = PgPointArray(bench::random_points<PgPoint>(n));
+  const auto geom = fun::CKRuntimeGeometry<>(Geom{});
+  for (auto _ : state) {
+    auto res = geom.perp(pts);
+    benchmark::DoNotOptimize(res.columns()[0]);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+// All-pairs quadrances of state.range(0) hyperbolic points. Items are the
+// n^2 entries; quadrance_matrix computes and stores the upper triangle.
+
+void bench_quadrance_naive(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = bench::random_points<HypPoint>(n);
+  std::vector<int64_t> num(n * n);
+  std::vector<int64_t> den(n * n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i != n; ++i) {
+      for (std::size_t j = 0; j != n; ++j) {
+        const auto pi = pts[i].perp();
+        const auto pj = pts[j].perp();
+        const auto ab = pts[i].dot(pj);
+        den[i * n + j] = pts[i].dot(pi) * pts[j].dot(pj);
+        num[i * n + j] = den[i * n + j] - ab * ab;
+      }
+    }
+    benchmark::DoNotOptimize(num.data());
+    benchmark::DoNotOptimize(den.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n * n));
+}
+
+void bench_quadrance_matrix(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts = bench::random_points<HypPoint>(n);
+  for (auto _ : state) {
+    auto res = fun::quadrance_matrix(pts);
+    benchmark::DoNotOptimize(res.num.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n * n));
+}
+
+// Sides, altitudes, orthocenter and orthic triangle of state.range(0)
+// hyperbolic triangles.
+
+void bench_triangles_scalar(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto tris = bench::random_triangles<HypPoint>(n);
+  for (auto _ : state) {
+    for (const auto &tri : tris) {
+      const auto sides = fun::tri_dual(tri);
+      const auto alts = fun::tri_altitude(tri);
+      auto o = fun::orthocenter(tri);
+      benchmark::DoNotOptimize(o);
+      for (std::size_t k = 0; k != 3; ++k) {
+        auto foot = alts[k].circ(sides[k]);
+        benchmark::DoNotOptimize(foot);
+      }
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+// The same outputs as the scalar loop: orthocenter and orthic triangle.
+void bench_triangles_batch(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto tris =
+      fun::TriangleArray<HypPoint>(bench::random_triangles<HypPoint>(n));
+  auto res = fun::TriangleCenters<HypPoint>{};
+  for (auto _ : state) {
+    fun::triangle_centers(tris, res,
+                          fun::TriangleOutput::Orthocenter |
+                              fun::TriangleOutput::Orthic);
+    benchmark::DoNotOptimize(res.orthocenter.columns()[0]);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+template <class P> void bench_orthocenter_batch(benchmark::State &state) {
+  const auto tris = fun::TriangleArray<P>(bench::random_triangles<P>(kCount));
+  auto res = fun::TriangleCenters<P>{};
+  for (auto _ : state) {
+    fun::triangle_centers(tris, res, fun::TriangleOutput::Orthocenter);
+    benchmark::DoNotOptimize(res.orthocenter.columns()[0]);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * kCount);
+}
+
+// A frame of a dynamic construction: a triangle a1 a2 a3 and state.range(0)
+// free points p, each reflected in a1 a2 (r) and in a2 a3 (s), with the
+// altitude from s to a1 a2. Only a3 moves, which dirties about two thirds
+// of the objects. Coordinates are bounded by kTinyBound so that every
+// intermediate stays within int64.
+
+void bench_construction_full(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts =
+      bench::random_points<HypPoint>(n + 4, bench::kSeed, bench::kTinyBound);
+  auto tri = std::array{pts[n], pts[n + 1], pts[n + 2]};
+  auto refl = std::vector<HypPoint>(2 * n, pts[0]);
+  auto alts = std::vector<HypLine>(n, pts[0].perp());
+  std::size_t frame = 0;
+  for (auto _ : state) {
+    tri[2] = pts[n + 2 + frame++ % 2];
+    const auto l = tri[0].circ(tri[1]);
+    const auto m = tri[1].circ(tri[2]);
+    for (std::size_t i = 0; i != n; ++i) {
+      refl[2 * i] = fun::reflect<int64_t>(pts[i], l, pts[i]);
+      refl[2 * i + 1] = fun::reflect<int64_t>(pts[i], m, pts[i]);
+      alts[i] = fun::altitude(refl[2 * i + 1], l);
+    }
+    benchmark::DoNotOptimize(alts.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+void bench_construction_update(benchmark::State &state) {
+  const auto n = std::size_t(state.range(0));
+  const auto pts =
+      bench::random_points<HypPoint>(n + 4, bench::kSeed, bench::kTinyBound);
+  auto g = fun::Construction<HypPoint>{};
+  const auto a1 = g.point(pts[n]);
+  const auto a2 = g.point(pts[n + 1]);
+  const auto a3 = g.point(pts[n + 2]);
+  const auto l = g.join(a1, a2);
+  const auto m = g.join(a2, a3);
+  for (std::size_t i = 0; i != n; ++i) {
+    const auto p = g.point(pts[i]);
+    g.reflect(l, p);
+    g.altitude(g.reflect(m, p), l);
+  }
+  std::size_t frame = 0;
+  for (auto _ : state) {
+    g.move(a3, pts[n + 2 + frame++ % 2]);
+    benchmark::DoNotOptimize(g.update());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n));
+}
+
+} // namespace
+
+#define PROJGEOM_BENCH_PG(name, Point, WidePoint)                              \
+  BENCHMARK(bench_circ<Point>)->Name(name "/circ");                            \
+  BENCHMARK(bench_incident<Point>)->Name(name "/incident");                    \
+  BENCHMARK(bench_harm_conj<Point>)->Name(name "/harm_conj");                  \
+  BENCHMARK(bench_involution<Point>)->Name(name "/involution");                \
+  BENCHMARK(bench_involution_matrix<Point>)                                    \
+      ->Name(name "/involution_matrix");                                       \
+  BENCHMARK(bench_check_pappus<WidePoint>)->Name(name "/check_pappus");        \
+  BENCHMARK(bench_check_pappus_fused<WidePoint>)                               \
+      ->Name(name "/check_pappus_fused");                                      \
+  BENCHMARK(bench_check_desargue<WidePoint>)->Name(name "/check_desargue")
+
+#define PROJGEOM_BENCH_CK(name, Point, WidePoint)                              \
+  PROJGEOM_BENCH_PG(name, Point, WidePoint);                                   \
+  BENCHMARK(bench_perp<Point>)->Name(name "/perp");                            \
+  BENCHMARK(bench_orthocenter<Point>)->Name(name "/orthocenter")
+
+PROJGEOM_BENCH_PG("Pg", PgPoint, BasicPgPoint<WideInt>);
+PROJGEOM_BENCH_CK("Ell", EllPoint, BasicEllPoint<WideInt>);
+PROJGEOM_BENCH_CK("Hyp", HypPoint, BasicHypPoint<WideInt>);
+PROJGEOM_BENCH_CK("Persp", PerspPoint, BasicPerspPoint<WideInt>);
+PROJGEOM_BENCH_CK("MyCK", MyCKPoint, BasicMyCKPoint<WideInt>);
+
+BENCHMARK(bench_perp_batch<HypGeometry>)->Name("Hyp/perp_batch")->Arg(1 << 14);
+BENCHMARK(bench_perp_runtime<HypGeometry>)
+    ->Name("Hyp/perp_runtime")
+    ->Arg(1 << 14);
+BENCHMARK(bench_perp_batch<MyCKGeometry>)
+    ->Name("MyCK/perp_batch")
+    ->Arg(1 << 14);
+BENCHMARK(bench_perp_runtime<MyCKGeometry>)
+    ->Name("MyCK/perp_runtime")
+    ->Arg(1 << 14);
+
+BENCHMARK(bench_side)->Name("Oriented/side")->Arg(1 << 14)->Arg(1 << 20);
+BENCHMARK(bench_side_of)->Name("Oriented/side_of")->Arg(1 << 14)->Arg(1 << 20);
+
+BENCHMARK(bench_arrangement_naive)->Name("Arrangement/naive")->Arg(128);
+BENCHMARK(bench_arrangement)->Name("Arrangement/tiled")->Arg(128)->Arg(2048);
+
+BENCHMARK(bench_collinear_naive)->Name("Collinear/naive")->Arg(256);
+BENCHMARK(bench_collinear_groups)
+    ->Name("Collinear/hashed")
+    ->Arg(256)
+    ->Arg(4096);
+
+BENCHMARK(bench_map_point)->Name("Homography/map_point")->Arg(1 << 16);
+BENCHMARK(bench_map_points)->Name("Homography/map_points")->Arg(1 << 16);
+
+BENCHMARK(bench_quadrance_naive)->Name("Rational/quadrance_naive")->Arg(1024);
+BENCHMARK(bench_quadrance_matrix)
+    ->Name("Rational/quadrance_matrix")
+    ->Arg(1024);
+
+BENCHMARK(bench_triangles_scalar)->Name("Triangles/scalar")->Arg(1 << 14);
+BENCHMARK(bench_triangles_batch)->Name("Triangles/batch")->Arg(1 << 14);
+BENCHMARK(bench_orthocenter_batch<HypPoint>)->Name("Hyp/orthocenter_batch");
+BENCHMARK(bench_construction_full)->Name("Construction/full")->Arg(256);
+BENCHMARK(bench_construction_update)->Name("Construction/update")->Arg(256);
+
+#undef PROJGEOM_BENCH_CK
+#undef PROJGEOM_BENCH_PG
+
+BENCHMARK_MAIN();
@@ -0,0 +1,334 @@
+#pragma once
+
+/** @file include/projgeom/adaptive_int.hpp
+ *  Exact integer scalar that runs on int64 and widens on overflow.
+ */
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "bigint.hpp"
+#include "int128.hpp"
+
+namespace fun {
+
+/**
+ * @brief Adaptive-precision integer
+ *
+ * Arithmetic runs on int64_t with overflow detection. Only an operation
+ * that overflows is redone in __int128, and only one that overflows
+ * __int128 is redone in BigInt (without __int128, e.g. on MSVC, overflows
+ * go straight to BigInt and Rep::Wide is never used). Results are always
+ * stored in the narrowest representation that holds them, so values that
+ * shrink again (e.g. after a subtraction) return to the fast path. The three
+ * representations share one union, so an AdaptiveInt is three words.
+ */
+class AdaptiveInt {
+public:
+  /**  Current representation */
+  enum class Rep : uint8_t { Small, Wide, Big };
+
+private:
+  /**  Two's complement __int128 as two words, so that Value only needs the
+   *   alignment of int64_t */
+  struct Words {
+    uint64_t lo;
+    uint64_t hi;
+  };
+
+  /**  The payload, keyed on _rep */
+  union Value {
+    int64_t small;
+    Words wide;
+    BigInt *big; // owned
+  };
+
+  Rep _rep{Rep::Small};
+  Value _val{0};
+
+#if PROJGEOM_HAS_INT128
+  static auto from_wide(__int128 value) -> AdaptiveInt {
+    auto res = AdaptiveInt{};
+    if (value >= INT64_MIN && value <= INT64_MAX) {
+      res._val.small = static_cast<int64_t>(value);
+    } else {
+      const auto bits = static_cast<unsigned __int128>(value);
+      res._rep = Rep::Wide;
+      res._val.wide = {static_cast<uint64_t>(bits),
+                       static_cast<uint64_t>(bits >> 64)};
+    }
+    return res;
+  }
+
+  [[nodiscard]] auto wide() const noexcept -> __int128 {
+    if (this->_rep == Rep::Small) {
+      return this->_val.small;
+    }
+    const auto &[lo, hi] = this->_val.wide;
+    return static_cast<__int128>((static_cast<unsigned __int128>(hi) << 64) |
+                                 lo);
+  }
+#endif
+
+  static auto from_big(BigInt value) -> AdaptiveInt {
+#if PROJGEOM_HAS_INT128
+    if (value.fits_int128()) {
+      return from_wide(value.to_int128());
+    }
+#else
+    if (value.fits_int64()) {
+      return AdaptiveInt(value.to_int64());
+    }
+#endif
+    auto res = AdaptiveInt{};
+    res._rep = Rep::Big;
+    res._val.big = new BigInt(std::move(value));
+    return res;
+  }
+
+  // The slow paths are kept out of line so that the int64 fast path of the
+  // operators stays small enough to be inlined.
+
+  PROJGEOM_NOINLINE static auto add_slow(const AdaptiveInt &lhs,
+                                         const AdaptiveInt &rhs)
+      -> AdaptiveInt {
+#if PROJGEOM_HAS_INT128
+    __int128 res;
+    if (lhs._rep != Rep::Big && rhs._rep != Rep::Big &&
+        !__builtin_add_overflow(lhs.wide(), rhs.wide(), &res)) {
+      return from_wide(res);
+    }
+#endif
+    return from_big(lhs.to_big() + rhs.to_big());
+  }
+
+  PROJGEOM_NOINLINE static auto sub_slow(const AdaptiveInt &lhs,
+                                         const AdaptiveInt &rhs)
+      -> AdaptiveInt {
+#if PROJGEOM_HAS_INT128
+    __int128 res;
+    if (lhs._rep != Rep::Big && rhs._rep != Rep::Big &&
+        !__builtin_sub_overflow(lhs.wide(), rhs.wide(), &res)) {
+      return from_wide(res);
+    }
+#endif
+    return from_big(lhs.to_big() - rhs.to_big());
+  }
+
+  PROJGEOM_NOINLINE static auto mul_slow(const AdaptiveInt &lhs,
+                                         const AdaptiveInt &rhs)
+      -> AdaptiveInt {
+#if PROJGEOM_HAS_INT128
+    __int128 res;
+    if (lhs._rep != Rep::Big && rhs._rep != Rep::Big &&
+        !__builtin_mul_overflow(lhs.wide(), rhs.wide(), &res)) {
+      return from_wide(res);
+    }
+#endif
+    return from_big(lhs.to_big() * rhs.to_big());
+  }
+
+public:
+  /**
+   * @brief Construct a zero AdaptiveInt
+   *
+   */
+  AdaptiveInt() = default;
+
+  /**
+   * @brief Construct a new AdaptiveInt object
+   *
+   * @param[in] value
+   */
+  AdaptiveInt(int64_t value) : _val{value} {}
+
+  /**
+   * @brief Construct a new AdaptiveInt object
+   *
+   * @param[in] value
+   */
+  AdaptiveInt(int value) : _val{value} {}
+
+  /**
+   * @brief Construct a new AdaptiveInt object
+   *
+   * @param[in] value
+   */
+  explicit AdaptiveInt(const BigInt &value) : AdaptiveInt(from_big(value)) {}
+
+  AdaptiveInt(const AdaptiveInt &other) : _rep{other._rep}, _val{other._val} {
+    if (this->_rep == Rep::Big) {
+      this->_val.big = new BigInt(*other._val.big);
+    }
+  }
+
+  AdaptiveInt(AdaptiveInt &&other) noexcept
+      : _rep{other._rep}, _val{other._val} {
+    other._rep = Rep::Small;
+    other._val.small = 0;
+  }
+
+  auto operator=(const AdaptiveInt &other) -> AdaptiveInt & {
+    if (this != &other) {
+      *this = AdaptiveInt(other);
+    }
+    return *this;
+  }
+
+  auto operator=(AdaptiveInt &&other) noexcept -> AdaptiveInt & {
+    std::swap(this->_rep, other._rep);
+    std::swap(this->_val, other._val);
+    return *this;
+  }
+
+  ~AdaptiveInt() {
+    if (this->_rep == Rep::Big) {
+      delete this->_val.big;
+    }
+  }
+
+  /**
+   * @brief Current representation
+   *
+   * @return Rep
+   */
+  [[nodiscard]] auto rep() const noexcept -> Rep { return this->_rep; }
+
+  /**
+   * @brief Sign of the value
+   *
+   * @return int -1, 0 or 1
+   */
+  [[nodiscard]] auto sign() const noexcept -> int {
+    switch (this->_rep) {
+    case Rep::Small:
+      return (this->_val.small > 0) - (this->_val.small < 0);
+    case Rep::Wide:
+      return static_cast<int64_t>(this->_val.wide.hi) < 0 ? -1 : 1;
+    default:
+      return this->_val.big->sign();
+    }
+  }
+
+  /**
+   * @brief Convert to BigInt
+   *
+   * @return BigInt
+   */
+  [[nodiscard]] auto to_big() const -> BigInt {
+#if PROJGEOM_HAS_INT128
+    return this->_rep == Rep::Big ? *this->_val.big : BigInt(this->wide());
+#else
+    return this->_rep == Rep::Big ? *this->_val.big : BigInt(this->_val.small);
+#endif
+  }
+
+  /**
+   * @brief Decimal representation
+   *
+   * @return std::string
+   */
+  [[nodiscard]] auto to_string() const -> std::string {
+    return this->to_big().to_string();
+  }
+
+  friend auto operator+(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> AdaptiveInt {
+    int64_t res;
+    if (lhs._rep == Rep::Small && rhs._rep == Rep::Small &&
+        !detail::add_overflow(lhs._val.small, rhs._val.small, &res))
+        [[likely]] {
+      return AdaptiveInt(res);
+    }
+    return add_slow(lhs, rhs);
+  }
+
+  friend auto operator-(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> AdaptiveInt {
+    int64_t res;
+    if (lhs._rep == Rep::Small && rhs._rep == Rep::Small &&
+        !detail::sub_overflow(lhs._val.small, rhs._val.small, &res))
+        [[likely]] {
+      return AdaptiveInt(res);
+    }
+    return sub_slow(lhs, rhs);
+  }
+
+  friend auto operator*(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> AdaptiveInt {
+    int64_t res;
+    if (lhs._rep == Rep::Small && rhs._rep == Rep::Small &&
+        !detail::mul_overflow(lhs._val.small, rhs._val.small, &res))
+        [[likely]] {
+      return AdaptiveInt(res);
+    }
+    return mul_slow(lhs, rhs);
+  }
+
+  auto operator-() const -> AdaptiveInt { return AdaptiveInt{} - *this; }
+
+  auto operator+=(const AdaptiveInt &rhs) -> AdaptiveInt & {
+    return *this = *this + rhs;
+  }
+
+  auto operator-=(const AdaptiveInt &rhs) -> AdaptiveInt & {
+    return *this = *this - rhs;
+  }
+
+  auto operator*=(const AdaptiveInt &rhs) -> AdaptiveInt & {
+    return *this = *this * rhs;
+  }
+
+  friend auto operator==(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> bool {
+    if (lhs.rep() != rhs.rep()) {
+      return false; // representations are canonical
+    }
+    switch (lhs.rep()) {
+    case Rep::Small:
+      return lhs._val.small == rhs._val.small;
+    case Rep::Wide:
+      return lhs._val.wide.lo == rhs._val.wide.lo &&
+             lhs._val.wide.hi == rhs._val.wide.hi;
+    default:
+      return *lhs._val.big == *rhs._val.big;
+    }
+  }
+
+  friend auto operator!=(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> bool {
+    return !(lhs == rhs);
+  }
+
+  friend auto operator<(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> bool {
+    if (lhs._rep == Rep::Small && rhs._rep == Rep::Small) {
+      return lhs._val.small < rhs._val.small;
+    }
+    return (lhs - rhs).sign() < 0;
+  }
+
+  friend auto operator>(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> bool {
+    return rhs < lhs;
+  }
+
+  friend auto operator<=(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> bool {
+    return !(rhs < lhs);
+  }
+
+  friend auto operator>=(const AdaptiveInt &lhs, const AdaptiveInt &rhs)
+      -> bool {
+    return !(lhs < rhs);
+  }
+
+  template <typename _Stream>
+  friend auto operator<<(_Stream &os, const AdaptiveInt &a) -> _Stream & {
+    os << a.to_string();
+    return os;
+  }
+};
+
+} // namespace fun
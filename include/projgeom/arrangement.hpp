@@ -0,0 +1,314 @@
+#pragma once
+
+/** @file include/projgeom/arrangement.hpp
+ *  Arrangement of lines: every pairwise meet, deduplicated, with the lines
+ *  through each point in a compressed (CSR) incidence structure.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "canonical.hpp"
+#include "parallel.hpp"
+#include "pg_array.hpp"
+#include "pg_simd.hpp"
+
+namespace fun {
+
+/**
+ * @brief Intersection points of an arrangement and their incident lines
+ *
+ * The lines through points[k] are lines[offsets[k] .. offsets[k + 1]),
+ * as indices into the input, in increasing order. Points are in canonical
+ * form and ordered by the first pair of lines (i, j), i < j, that meets
+ * there, so the result does not depend on the number of threads.
+ *
+ * @tparam P Point (the Dual of the input lines)
+ */
+template <class P> struct Arrangement {
+  std::vector<P> points;
+  std::vector<std::size_t> offsets{0};
+  std::vector<uint32_t> lines;
+  std::size_t degenerate_pairs{}; //!< pairs of equal (or zero) lines
+
+  /**
+   * @brief Number of distinct intersection points
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto num_points() const noexcept -> std::size_t {
+    return this->points.size();
+  }
+
+  /**
+   * @brief Number of lines through points[k]
+   *
+   * @param[in] k
+   * @return std::size_t
+   */
+  [[nodiscard]] auto degree(std::size_t k) const -> std::size_t {
+    return this->offsets[k + 1] - this->offsets[k];
+  }
+
+  /**
+   * @brief Indices of the lines through points[k]
+   *
+   * @param[in] k
+   * @return std::span<const uint32_t>
+   */
+  [[nodiscard]] auto lines_through(std::size_t k) const
+      -> std::span<const uint32_t> {
+    return {this->lines.data() + this->offsets[k], this->degree(k)};
+  }
+};
+
+/**
+ * @brief Build the arrangement of a set of lines
+ *
+ * The pairwise meets are computed tile by tile (a block of `tile` lines
+ * against another, which stays in L1) in parallel over row blocks, using
+ * the SIMD cross kernel for int64 coordinates. Each meet is canonicalized
+ * and queued for one of several hash shards; a full queue is drained
+ * under the shard's lock into its open-addressing table, so only distinct
+ * points (plus their incidences) are kept, never the O(N^2) raw meets.
+ * The shards are then sorted and turned into CSR form in parallel, and
+ * merged. Works verbatim on points too (the dual arrangement: every line
+ * through two of the points, with the points on it).
+ *
+ * int64 coordinates below 2^31 in magnitude take the SIMD kernel; larger
+ * ones fall back to the exact canonical_cross(), which requires every
+ * meet to fit in int64 once reduced (asserted).
+ *
+ * @tparam L Line (or Point) with integer coordinates
+ * @param[in] lns
+ * @param[in] num_threads (0: default_concurrency())
+ * @param[in] tile block size
+ * @return Arrangement<typename L::Dual>
+ */
+template <class L>
+auto arrangement(const std::vector<L> &lns, unsigned num_threads = 0,
+                 std::size_t tile = 64) -> Arrangement<typename L::Dual> {
+  using P = typename L::Dual;
+  using T = typename L::value_type;
+  using Key = Canonical<P>;
+  using Pair = std::pair<uint32_t, uint32_t>;
+  struct Meet {
+    Key pt;
+    std::size_t hash;
+    Pair pair;
+  };
+  struct Shard {
+    std::mutex mutex;
+    // low 32 hash bits : point id + 1 (0 = empty), load <= 1/2
+    std::vector<uint64_t> slots;
+    std::vector<Key> pts;
+    std::vector<Pair> first;
+    std::vector<Pair> inc; // (point id, line) incidences
+    std::vector<std::size_t> offsets; // CSR over pts, as in Arrangement
+    std::vector<uint32_t> lines;
+  };
+  constexpr std::size_t queue_size = 256;
+
+  const auto n = lns.size();
+  if (num_threads == 0) {
+    num_threads = default_concurrency();
+  }
+  const auto num_blocks = (n + tile - 1) / tile;
+  const auto num_shards = std::size_t(num_threads) * 4;
+  const auto cols = PgArray<L>(lns);
+
+  std::vector<Shard> shards(num_shards);
+  const auto drain = [](Shard &sh, std::vector<Meet> &queue) {
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    for (const auto &[key, hash, pair] : queue) {
+      if (2 * (sh.pts.size() + 1) > sh.slots.size()) {
+        // grow; the low hash bits kept in each slot place it again
+        auto old = std::move(sh.slots);
+        sh.slots.assign(std::max<std::size_t>(64, 2 * old.size()), 0);
+        const auto mask = sh.slots.size() - 1;
+        for (const auto slot : old) {
+          if (slot == 0) {
+            continue;
+          }
+          auto h = (slot >> 32) & mask;
+          while (sh.slots[h] != 0) {
+            h = (h + 1) & mask;
+          }
+          sh.slots[h] = slot;
+        }
+      }
+      const auto mask = sh.slots.size() - 1;
+      const auto tag = uint64_t(uint32_t(hash)) << 32;
+      auto h = hash & mask;
+      while (sh.slots[h] != 0 &&
+             ((sh.slots[h] >> 32 << 32) != tag ||
+              sh.pts[uint32_t(sh.slots[h]) - 1] != key)) {
+        h = (h + 1) & mask;
+      }
+      if (sh.slots[h] == 0) {
+        sh.pts.push_back(key);
+        sh.first.push_back(pair);
+        sh.slots[h] = tag | sh.pts.size();
+      }
+      const auto id = uint32_t(sh.slots[h]) - 1;
+      sh.first[id] = std::min(sh.first[id], pair);
+      sh.inc.push_back({id, pair.first});
+      sh.inc.push_back({id, pair.second});
+    }
+    queue.clear();
+  };
+
+  std::vector<std::size_t> degenerate(num_blocks);
+  parallel_for(
+      num_blocks,
+      [&](std::size_t begin, std::size_t end) {
+        std::array<std::vector<T>, 3> buf;
+        for (auto &col : buf) {
+          col.resize(tile);
+        }
+        std::vector<std::vector<Meet>> queues(num_shards);
+        for (auto b = begin; b != end; ++b) {
+          const auto i0 = b * tile;
+          const auto i1 = std::min(n, i0 + tile);
+          for (auto j0 = i0; j0 < n; j0 += tile) {
+            const auto j1 = std::min(n, j0 + tile);
+            for (auto i = i0; i != i1; ++i) {
+              const auto lo = std::max(i + 1, j0);
+              if (lo >= j1) {
+                continue;
+              }
+              const auto m = j1 - lo;
+              const auto &li = lns[i].coord;
+              if constexpr (std::is_same_v<T, int64_t>) {
+                const auto a = cols.columns();
+                exact_cross_batch({a[0] + lo, a[1] + lo, a[2] + lo}, li,
+                                  {buf[0].data(), buf[1].data(),
+                                   buf[2].data()},
+                                  m);
+              } else {
+                for (std::size_t t = 0; t != m; ++t) {
+                  const auto c = ::cross(lns[lo + t].coord, li);
+                  for (std::size_t k = 0; k != 3; ++k) {
+                    buf[k][t] = c[k];
+                  }
+                }
+              }
+              for (std::size_t t = 0; t != m; ++t) {
+                const auto pt = P({buf[0][t], buf[1][t], buf[2][t]});
+                if (pt.coord == std::array<T, 3>{}) {
+                  ++degenerate[b];
+                  continue;
+                }
+                const auto key = Key{pt};
+                const auto hash = key.hash();
+                // high bits pick the shard, low bits the slot within it
+                const auto s = (hash >> 32) % num_shards;
+                queues[s].push_back(
+                    {key, hash, {uint32_t(i), uint32_t(lo + t)}});
+                if (queues[s].size() == queue_size) {
+                  drain(shards[s], queues[s]);
+                }
+              }
+            }
+          }
+        }
+        for (std::size_t s = 0; s != num_shards; ++s) {
+          drain(shards[s], queues[s]);
+        }
+      },
+      1, num_threads);
+
+  parallel_for(
+      num_shards,
+      [&](std::size_t begin, std::size_t end) {
+        for (auto s = begin; s != end; ++s) {
+          auto &sh = shards[s];
+          std::vector<uint64_t>{}.swap(sh.slots);
+          // renumber the points in order of their first meeting pair
+          const auto num = sh.pts.size();
+          std::vector<uint32_t> perm(num);
+          std::iota(perm.begin(), perm.end(), 0U);
+          std::sort(perm.begin(), perm.end(), [&](uint32_t x, uint32_t y) {
+            return sh.first[x] < sh.first[y];
+          });
+          std::vector<uint32_t> rank(num);
+          std::vector<Key> pts;
+          std::vector<Pair> first;
+          pts.reserve(num);
+          first.reserve(num);
+          for (std::size_t k = 0; k != num; ++k) {
+            rank[perm[k]] = uint32_t(k);
+            pts.push_back(sh.pts[perm[k]]);
+            first.push_back(sh.first[perm[k]]);
+          }
+          sh.pts.swap(pts);
+          sh.first.swap(first);
+          auto &inc = sh.inc;
+          for (auto &entry : inc) {
+            entry.first = rank[entry.first];
+          }
+          std::sort(inc.begin(), inc.end());
+          inc.erase(std::unique(inc.begin(), inc.end()), inc.end());
+          sh.offsets.assign(sh.pts.size() + 1, 0);
+          sh.lines.reserve(inc.size());
+          for (const auto &[id, line] : inc) {
+            ++sh.offsets[id + 1];
+            sh.lines.push_back(line);
+          }
+          std::vector<Pair>{}.swap(inc);
+          for (std::size_t k = 0; k != sh.pts.size(); ++k) {
+            sh.offsets[k + 1] += sh.offsets[k];
+          }
+        }
+      },
+      1, num_threads);
+
+  // merge the sorted shards in order of the first meeting pair
+  auto res = Arrangement<P>{};
+  std::size_t num_points = 0;
+  std::size_t num_lines = 0;
+  for (const auto &sh : shards) {
+    num_points += sh.pts.size();
+    num_lines += sh.lines.size();
+  }
+  res.points.reserve(num_points);
+  res.offsets.reserve(num_points + 1);
+  res.lines.reserve(num_lines);
+  using Head = std::pair<Pair, std::size_t>; // (first pair, shard)
+  std::priority_queue<Head, std::vector<Head>, std::greater<>> heads;
+  std::vector<std::size_t> pos(num_shards);
+  for (std::size_t s = 0; s != num_shards; ++s) {
+    if (!shards[s].pts.empty()) {
+      heads.push({shards[s].first[0], s});
+    }
+  }
+  while (!heads.empty()) {
+    const auto s = heads.top().second;
+    heads.pop();
+    const auto &sh = shards[s];
+    const auto k = pos[s]++;
+    res.points.push_back(sh.pts[k].get());
+    res.lines.insert(res.lines.end(), sh.lines.begin() + sh.offsets[k],
+                     sh.lines.begin() + sh.offsets[k + 1]);
+    res.offsets.push_back(res.lines.size());
+    if (pos[s] != sh.pts.size()) {
+      heads.push({sh.first[pos[s]], s});
+    }
+  }
+  for (const auto d : degenerate) {
+    res.degenerate_pairs += d;
+  }
+  return res;
+}
+
+} // namespace fun
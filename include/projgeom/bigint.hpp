@@ -0,0 +1,345 @@
+#pragma once
+
+/** @file include/projgeom/bigint.hpp
+ *  Minimal arbitrary-precision signed integer (add, subtract, multiply,
+ *  compare). Used as the last resort of AdaptiveInt.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "int128.hpp"
+
+namespace fun {
+
+/**
+ * @brief Arbitrary-precision signed integer
+ *
+ * Sign-magnitude representation with 32-bit limbs, least significant first.
+ * Zero has no limbs and is never negative.
+ */
+class BigInt {
+  bool _neg{false};
+  std::vector<uint32_t> _mag;
+
+  static auto cmp_mag(const std::vector<uint32_t> &a,
+                      const std::vector<uint32_t> &b) -> int {
+    if (a.size() != b.size()) {
+      return a.size() < b.size() ? -1 : 1;
+    }
+    for (auto i = a.size(); i-- != 0;) {
+      if (a[i] != b[i]) {
+        return a[i] < b[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  static auto add_mag(const std::vector<uint32_t> &a,
+                      const std::vector<uint32_t> &b) -> std::vector<uint32_t> {
+    const auto &lng = a.size() >= b.size() ? a : b;
+    const auto &sht = a.size() >= b.size() ? b : a;
+    std::vector<uint32_t> res(lng.size() + 1);
+    uint64_t carry = 0;
+    for (std::size_t i = 0; i != lng.size(); ++i) {
+      carry += uint64_t(lng[i]) + (i < sht.size() ? sht[i] : 0U);
+      res[i] = uint32_t(carry);
+      carry >>= 32;
+    }
+    res.back() = uint32_t(carry);
+    return res;
+  }
+
+  /** requires |a| >= |b| */
+  static auto sub_mag(const std::vector<uint32_t> &a,
+                      const std::vector<uint32_t> &b) -> std::vector<uint32_t> {
+    std::vector<uint32_t> res(a.size());
+    int64_t borrow = 0;
+    for (std::size_t i = 0; i != a.size(); ++i) {
+      auto diff = int64_t(a[i]) - (i < b.size() ? int64_t(b[i]) : 0) - borrow;
+      borrow = diff < 0 ? 1 : 0;
+      res[i] = uint32_t(diff + (borrow << 32));
+    }
+    return res;
+  }
+
+  void trim() {
+    while (!this->_mag.empty() && this->_mag.back() == 0) {
+      this->_mag.pop_back();
+    }
+    if (this->_mag.empty()) {
+      this->_neg = false;
+    }
+  }
+
+  /**
+   * @brief Whether the value fits a two's complement integer of `bits`
+   *        bits (a multiple of 32), including its minimum -2^(bits - 1)
+   */
+  [[nodiscard]] auto fits_signed(std::size_t bits) const noexcept -> bool {
+    const auto width = this->bit_width();
+    if (width != bits) {
+      return width < bits;
+    }
+    return this->_neg && this->_mag.back() == uint32_t(1) << 31 &&
+           std::all_of(this->_mag.begin(), this->_mag.end() - 1,
+                       [](uint32_t limb) { return limb == 0; });
+  }
+
+  /**
+   * @brief Add a signed magnitude
+   */
+  auto add_signed(bool neg, const std::vector<uint32_t> &mag) -> BigInt & {
+    if (this->_neg == neg) {
+      this->_mag = add_mag(this->_mag, mag);
+    } else if (cmp_mag(this->_mag, mag) >= 0) {
+      this->_mag = sub_mag(this->_mag, mag);
+    } else {
+      this->_mag = sub_mag(mag, this->_mag);
+      this->_neg = neg;
+    }
+    this->trim();
+    return *this;
+  }
+
+public:
+  /**
+   * @brief Construct a zero BigInt
+   *
+   */
+  BigInt() = default;
+
+  /**
+   * @brief Construct a new BigInt object
+   *
+   * @param[in] value any built-in signed integer
+   */
+  BigInt(widest_int value) : _neg{value < 0} {
+#if PROJGEOM_HAS_INT128
+    auto mag = this->_neg ? -static_cast<unsigned __int128>(value)
+                          : static_cast<unsigned __int128>(value);
+#else
+    auto mag = this->_neg ? uint64_t(0) - static_cast<uint64_t>(value)
+                          : static_cast<uint64_t>(value);
+#endif
+    while (mag != 0) {
+      this->_mag.push_back(uint32_t(mag));
+      mag >>= 32;
+    }
+  }
+
+  /**
+   * @brief Sign of the value
+   *
+   * @return int -1, 0 or 1
+   */
+  [[nodiscard]] auto sign() const noexcept -> int {
+    return this->_mag.empty() ? 0 : (this->_neg ? -1 : 1);
+  }
+
+  /**
+   * @brief Number of significant bits of the magnitude
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto bit_width() const noexcept -> std::size_t {
+    if (this->_mag.empty()) {
+      return 0;
+    }
+    auto top = this->_mag.back();
+    std::size_t bits = 32 * (this->_mag.size() - 1);
+    while (top != 0) {
+      ++bits;
+      top >>= 1;
+    }
+    return bits;
+  }
+
+#if PROJGEOM_HAS_INT128
+  /**
+   * @brief Whether the value is representable as __int128
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto fits_int128() const noexcept -> bool {
+    return this->fits_signed(128);
+  }
+
+  /**
+   * @brief Convert to __int128 (requires fits_int128())
+   *
+   * @return __int128
+   */
+  [[nodiscard]] auto to_int128() const noexcept -> __int128 {
+    unsigned __int128 mag = 0;
+    for (auto i = this->_mag.size(); i-- != 0;) {
+      mag = (mag << 32) | this->_mag[i];
+    }
+    return static_cast<__int128>(this->_neg ? -mag : mag); // -2^127 too
+  }
+#endif
+
+  /**
+   * @brief Whether the value is representable as int64_t
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto fits_int64() const noexcept -> bool {
+    return this->fits_signed(64);
+  }
+
+  /**
+   * @brief Convert to int64_t (requires fits_int64())
+   *
+   * @return int64_t
+   */
+  [[nodiscard]] auto to_int64() const noexcept -> int64_t {
+    uint64_t mag = 0;
+    for (auto i = this->_mag.size(); i-- != 0;) {
+      mag = (mag << 32) | this->_mag[i];
+    }
+    return static_cast<int64_t>(this->_neg ? -mag : mag); // INT64_MIN too
+  }
+
+  /**
+   * @brief Residue modulo m, in [0, m)
+   *
+   * @param[in] m nonzero modulus
+   * @return uint64_t
+   */
+  [[nodiscard]] auto mod(uint64_t m) const noexcept -> uint64_t {
+    uint64_t r = 0;
+    for (auto i = this->_mag.size(); i-- != 0;) {
+      r = detail::mod_wide(r >> 32, (r << 32) | this->_mag[i], m);
+    }
+    return this->_neg && r != 0 ? m - r : r;
+  }
+
+  /**
+   * @brief Negate
+   *
+   * @return BigInt
+   */
+  auto operator-() const -> BigInt {
+    auto res = *this;
+    res._neg = !res._neg && !res._mag.empty();
+    return res;
+  }
+
+  auto operator+=(const BigInt &rhs) -> BigInt & {
+    return this->add_signed(rhs._neg, rhs._mag);
+  }
+
+  auto operator-=(const BigInt &rhs) -> BigInt & {
+    return this->add_signed(!rhs._neg, rhs._mag);
+  }
+
+  auto operator*=(const BigInt &rhs) -> BigInt & {
+    if (this->_mag.empty() || rhs._mag.empty()) {
+      return *this = BigInt{};
+    }
+    std::vector<uint32_t> res(this->_mag.size() + rhs._mag.size());
+    for (std::size_t i = 0; i != this->_mag.size(); ++i) {
+      uint64_t carry = 0;
+      for (std::size_t j = 0; j != rhs._mag.size(); ++j) {
+        carry += uint64_t(this->_mag[i]) * rhs._mag[j] + res[i + j];
+        res[i + j] = uint32_t(carry);
+        carry >>= 32;
+      }
+      res[i + rhs._mag.size()] = uint32_t(carry);
+    }
+    this->_mag = std::move(res);
+    this->_neg = this->_neg != rhs._neg;
+    this->trim();
+    return *this;
+  }
+
+  friend auto operator+(BigInt lhs, const BigInt &rhs) -> BigInt {
+    return lhs += rhs;
+  }
+
+  friend auto operator-(BigInt lhs, const BigInt &rhs) -> BigInt {
+    return lhs -= rhs;
+  }
+
+  friend auto operator*(BigInt lhs, const BigInt &rhs) -> BigInt {
+    return lhs *= rhs;
+  }
+
+  friend auto operator==(const BigInt &lhs, const BigInt &rhs) -> bool {
+    return lhs._neg == rhs._neg && lhs._mag == rhs._mag;
+  }
+
+  friend auto operator!=(const BigInt &lhs, const BigInt &rhs) -> bool {
+    return !(lhs == rhs);
+  }
+
+  friend auto operator<(const BigInt &lhs, const BigInt &rhs) -> bool {
+    if (lhs._neg != rhs._neg) {
+      return lhs._neg;
+    }
+    const auto c = cmp_mag(lhs._mag, rhs._mag);
+    return lhs._neg ? c > 0 : c < 0;
+  }
+
+  friend auto operator>(const BigInt &lhs, const BigInt &rhs) -> bool {
+    return rhs < lhs;
+  }
+
+  friend auto operator<=(const BigInt &lhs, const BigInt &rhs) -> bool {
+    return !(rhs < lhs);
+  }
+
+  friend auto operator>=(const BigInt &lhs, const BigInt &rhs) -> bool {
+    return !(lhs < rhs);
+  }
+
+  /**
+   * @brief Decimal representation
+   *
+   * @return std::string
+   */
+  [[nodiscard]] auto to_string() const -> std::string {
+    if (this->_mag.empty()) {
+      return "0";
+    }
+    auto mag = this->_mag;
+    std::string digits;
+    while (!mag.empty()) {
+      uint64_t rem = 0;
+      for (auto i = mag.size(); i-- != 0;) {
+        const auto cur = (rem << 32) | mag[i];
+        mag[i] = uint32_t(cur / 1000000000U);
+        rem = cur % 1000000000U;
+      }
+      while (!mag.empty() && mag.back() == 0) {
+        mag.pop_back();
+      }
+      for (int k = 0; k != 9; ++k) {
+        digits.push_back(char('0' + rem % 10));
+        rem /= 10;
+        if (mag.empty() && rem == 0) {
+          break;
+        }
+      }
+    }
+    if (this->_neg) {
+      digits.push_back('-');
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+  }
+
+  template <typename _Stream>
+  friend auto operator<<(_Stream &os, const BigInt &a) -> _Stream & {
+    os << a.to_string();
+    return os;
+  }
+};
+
+} // namespace fun
@@ -0,0 +1,229 @@
+#pragma once
+
+/** @file include/projgeom/canonical.hpp
+ *  Canonical form of integer homogeneous coordinates, with O(1) equality
+ *  and std::hash support.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "fractions.hpp"
+#include "int128.hpp"
+#include "pg_object.hpp"
+#include "pg_simd.hpp"
+
+namespace fun {
+
+/**
+ * @brief Canonical form of a projective point/line
+ *
+ * Divides the coordinates by their gcd and makes the first nonzero
+ * coordinate positive, so that two objects are projectively equal if and
+ * only if their canonical coordinates are identical.
+ *
+ * @tparam P Point (or Line) with integer coordinates
+ * @param[in] obj
+ * @return P
+ */
+template <class P> constexpr auto canonicalize(P obj) -> P {
+  using T = typename P::value_type;
+  auto &[x, y, z] = obj.coord;
+  const auto g = gcd(gcd(x, y), z);
+  if (g == T(0)) {
+    return obj;
+  }
+  const auto first = x != T(0) ? x : (y != T(0) ? y : z);
+  const auto d = first < T(0) ? -g : g;
+  if (d != T(1)) {
+    x /= d;
+    y /= d;
+    z /= d;
+  }
+  return obj;
+}
+
+/**
+ * @brief Projective point/line kept in canonical form
+ *
+ * Equality is a plain memcmp of the coordinates and hashing is O(1), so
+ * Canonical<P> can be used as a key of std::unordered_set/map.
+ *
+ * @tparam P Point (or Line) with integer coordinates
+ */
+template <class P> class Canonical {
+  using T = typename P::value_type;
+  static_assert(std::has_unique_object_representations_v<std::array<T, 3>>,
+                "Canonical requires integer coordinates");
+
+  P _obj;
+
+public:
+  /**
+   * @brief Construct a new Canonical object
+   *
+   * @param[in] obj
+   */
+  constexpr explicit Canonical(const P &obj) : _obj{canonicalize(obj)} {}
+
+  /**
+   * @brief The canonical representative
+   *
+   * @return const P&
+   */
+  [[nodiscard]] constexpr auto get() const noexcept -> const P & {
+    return this->_obj;
+  }
+
+  /**
+   * @brief Equal to
+   *
+   * @param[in] lhs
+   * @param[in] rhs
+   * @return true
+   * @return false
+   */
+  friend auto operator==(const Canonical &lhs, const Canonical &rhs) -> bool {
+    return std::memcmp(lhs._obj.coord.data(), rhs._obj.coord.data(),
+                       sizeof(lhs._obj.coord)) == 0;
+  }
+
+  /**
+   * @brief Not equal to
+   *
+   * @param[in] lhs
+   * @param[in] rhs
+   * @return true
+   * @return false
+   */
+  friend auto operator!=(const Canonical &lhs, const Canonical &rhs) -> bool {
+    return !(lhs == rhs);
+  }
+
+  /**
+   * @brief Hash value
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto hash() const noexcept -> std::size_t {
+    uint64_t h = 0x9e3779b97f4a7c15ULL;
+    for (const auto &c : this->_obj.coord) {
+      auto v = static_cast<uint64_t>(c);
+      if constexpr (sizeof(T) > sizeof(uint64_t)) {
+        v ^= static_cast<uint64_t>(c >> 64); // high word of a __int128
+      }
+      // splitmix64 finalizer
+      h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      h ^= h >> 30;
+      h *= 0xbf58476d1ce4e5b9ULL;
+      h ^= h >> 27;
+      h *= 0x94d049bb133111ebULL;
+      h ^= h >> 31;
+    }
+    return static_cast<std::size_t>(h);
+  }
+};
+
+/**
+ * @brief Cross product of two int64 triples, in canonical form
+ *
+ * The minors are taken in widest_int and divided by their gcd, so the
+ * result is exact whenever the reduced product fits in int64 (asserted).
+ * Without __int128 the unreduced minors must fit as well (asserted too).
+ *
+ * @param[in] a
+ * @param[in] b
+ * @return std::array<int64_t, 3> canonical a x b
+ */
+inline auto canonical_cross(const std::array<int64_t, 3> &a,
+                            const std::array<int64_t, 3> &b)
+    -> std::array<int64_t, 3> {
+  using W = widest_int;
+  const auto minor = [](int64_t p, int64_t q, int64_t r, int64_t s) -> W {
+#if PROJGEOM_HAS_INT128
+    return W(p) * q - W(r) * s;
+#else
+    int64_t pq = 0;
+    int64_t rs = 0;
+    int64_t res = 0;
+    [[maybe_unused]] const bool overflow = detail::mul_overflow(p, q, &pq) ||
+                                           detail::mul_overflow(r, s, &rs) ||
+                                           detail::sub_overflow(pq, rs, &res);
+    assert(!overflow && "canonical_cross: minor out of int64 range");
+    return res;
+#endif
+  };
+  auto c = std::array<W, 3>{minor(a[1], b[2], a[2], b[1]),
+                            minor(a[2], b[0], a[0], b[2]),
+                            minor(a[0], b[1], a[1], b[0])};
+  const auto g = gcd(gcd(c[0], c[1]), c[2]);
+  auto res = std::array<int64_t, 3>{};
+  if (g == W(0)) {
+    return res;
+  }
+  const auto first = c[0] != W(0) ? c[0] : (c[1] != W(0) ? c[1] : c[2]);
+  const auto d = first < W(0) ? -g : g;
+  for (std::size_t k = 0; k != 3; ++k) {
+    c[k] /= d;
+    assert(c[k] >= W(INT64_MIN) && c[k] <= W(INT64_MAX) &&
+           "canonical_cross: reduced product out of int64 range");
+    res[k] = int64_t(c[k]);
+  }
+  return res;
+}
+
+/**
+ * @brief Batch cross product with a fixed right operand, without wrapping
+ *
+ * Runs of elements whose coordinates (and b's) are all below 2^31 in
+ * magnitude, so that every minor fits in int64, go through the SIMD
+ * kernel; the others take canonical_cross(), which yields a projectively
+ * equal triple.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] c
+ * @param[in] n
+ */
+inline void exact_cross_batch(simd::ConstColumns a, const simd::Triple &b,
+                              simd::Columns c, std::size_t n) {
+  constexpr int64_t bound = int64_t(1) << 31;
+  constexpr std::size_t chunk = 256;
+  const auto b_small = std::all_of(b.begin(), b.end(), [](int64_t x) {
+    return x > -bound && x < bound;
+  });
+  for (std::size_t i = 0; i < n; i += chunk) {
+    const auto m = std::min(chunk, n - i);
+    auto small = b_small;
+    for (std::size_t k = 0; k != 3; ++k) {
+      for (std::size_t j = i; j != i + m; ++j) {
+        small &= a[k][j] > -bound && a[k][j] < bound;
+      }
+    }
+    if (small) {
+      simd::cross_batch({a[0] + i, a[1] + i, a[2] + i}, b,
+                        {c[0] + i, c[1] + i, c[2] + i}, m);
+    } else {
+      for (std::size_t j = i; j != i + m; ++j) {
+        const auto r = canonical_cross({a[0][j], a[1][j], a[2][j]}, b);
+        for (std::size_t k = 0; k != 3; ++k) {
+          c[k][j] = r[k];
+        }
+      }
+    }
+  }
+}
+
+} // namespace fun
+
+template <class P> struct std::hash<fun::Canonical<P>> {
+  auto operator()(const fun::Canonical<P> &obj) const noexcept -> std::size_t {
+    return obj.hash();
+  }
+};
@@ -0,0 +1,292 @@
+#pragma once
+
+/** @file include/projgeom/ck_geometry.hpp
+ *  Cayley-Klein geometries generated from a compile-time absolute conic.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ck_plane.hpp"
+#include "pg_array.hpp"
+#include "pg_object.hpp"
+
+/** Symmetric 3x3 matrix of an absolute conic, row-major */
+using CKMatrix = std::array<std::array<int64_t, 3>, 3>;
+
+/**
+ * @brief Diagonal conic a x^2 + b y^2 + c z^2
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @return CKMatrix
+ */
+constexpr auto ck_diagonal(int64_t a, int64_t b, int64_t c) -> CKMatrix {
+  return {{{a, 0, 0}, {0, b, 0}, {0, 0, c}}};
+}
+
+namespace fun::detail {
+
+constexpr auto ck_abs(int64_t a) -> int64_t { return a < 0 ? -a : a; }
+
+constexpr auto ck_gcd(int64_t a, int64_t b) -> int64_t {
+  while (b != 0) {
+    a %= b;
+    const auto t = a;
+    a = b;
+    b = t;
+  }
+  return ck_abs(a);
+}
+
+/**
+ * @brief Matrix of the line polarity: sign(det M) adj(M) divided by the
+ *        gcd of its entries, i.e. the smallest positive multiple of M^-1
+ */
+constexpr auto ck_line_polar(const CKMatrix &m) -> CKMatrix {
+  const auto r0 = ::cross(m[1], m[2]);
+  const auto r1 = ::cross(m[2], m[0]);
+  const auto r2 = ::cross(m[0], m[1]);
+  const auto det = ::dot(m[0], r0);
+  CKMatrix res{{{r0[0], r1[0], r2[0]}, // adj(M) has columns r0, r1, r2
+                 {r0[1], r1[1], r2[1]},
+                 {r0[2], r1[2], r2[2]}}};
+  auto g = int64_t(0);
+  for (const auto &row : res) {
+    for (const auto v : row) {
+      g = ck_gcd(g, v);
+    }
+  }
+  if (g == 0) {
+    return res; // degenerate conic
+  }
+  for (auto &row : res) {
+    for (auto &v : row) {
+      v = det < 0 ? -v / g : v / g;
+    }
+  }
+  return res;
+}
+
+template <int64_t C, typename T> constexpr auto ck_scaled(const T &x) -> T {
+  if constexpr (C == 1) {
+    return x;
+  } else if constexpr (C == -1) {
+    return -x;
+  } else {
+    return T(C) * x;
+  }
+}
+
+/**
+ * @brief Row . v with the zero, unit and sign coefficients folded away at
+ *        compile time
+ */
+template <std::array<int64_t, 3> Row, std::size_t J = 0, typename T>
+constexpr auto ck_row_dot(const std::array<T, 3> &v) -> T {
+  if constexpr (J == 3) {
+    return T(0);
+  } else if constexpr (Row[J] == 0) {
+    return ck_row_dot<Row, J + 1>(v);
+  } else if constexpr ((J == 2 || Row[2] == 0) && (J >= 1 || Row[1] == 0)) {
+    return ck_scaled<Row[J]>(v[J]); // last nonzero coefficient
+  } else {
+    return ck_scaled<Row[J]>(v[J]) + ck_row_dot<Row, J + 1>(v);
+  }
+}
+
+template <CKMatrix M, typename T>
+constexpr auto ck_apply(const std::array<T, 3> &v) -> std::array<T, 3> {
+  return {ck_row_dot<M[0]>(v), ck_row_dot<M[1]>(v), ck_row_dot<M[2]>(v)};
+}
+
+template <int64_t C, typename T>
+void ck_scale_column(const T *__restrict a, T *__restrict c, std::size_t n) {
+  for (std::size_t i = 0; i != n; ++i) {
+    c[i] = ck_scaled<C>(a[i]);
+  }
+}
+
+// c[0, n) = M a, column-wise. The columns of a and c are distinct arrays;
+// restrict says so, which the loops need to be vectorized at all. A
+// diagonal M (every built-in geometry) is applied one column at a time.
+template <CKMatrix M, typename T>
+void ck_apply_columns(const T *__restrict a0, const T *__restrict a1,
+                      const T *__restrict a2, T *__restrict c0,
+                      T *__restrict c1, T *__restrict c2, std::size_t n) {
+  if constexpr (M[0][1] == 0 && M[0][2] == 0 && M[1][2] == 0) {
+    ck_scale_column<M[0][0]>(a0, c0, n);
+    ck_scale_column<M[1][1]>(a1, c1, n);
+    ck_scale_column<M[2][2]>(a2, c2, n);
+    return;
+  }
+  for (std::size_t i = 0; i != n; ++i) {
+    const auto v = ck_apply<M>(std::array<T, 3>{a0[i], a1[i], a2[i]});
+    c0[i] = v[0];
+    c1[i] = v[1];
+    c2[i] = v[2];
+  }
+}
+
+} // namespace fun::detail
+
+template <class Geom, typename T> class BasicCKPoint;
+template <class Geom, typename T> class BasicCKLine;
+
+/**
+ * @brief Cayley-Klein geometry of a fixed, nondegenerate absolute conic
+ *
+ * The polarity sends a point p to the line M p and a line l to the point
+ * adj(M) l (normalized as in line_polar). Both matrices are template
+ * constants, so perp() compiles to just the nonzero products, e.g.
+ * {x, y, -z} for the hyperbolic plane. A new geometry is one line:
+ *
+ *     using MyGeometry = CKGeometry<ck_diagonal(-2, 1, -2)>;
+ *
+ * @tparam M symmetric conic matrix
+ */
+template <CKMatrix M> struct CKGeometry {
+  static constexpr CKMatrix point_polar = M;
+  static constexpr CKMatrix line_polar = fun::detail::ck_line_polar(M);
+
+  static_assert(M[0][1] == M[1][0] && M[0][2] == M[2][0] &&
+                    M[1][2] == M[2][1],
+                "the absolute conic must be symmetric");
+  static_assert(::dot(M[0], ::cross(M[1], M[2])) != 0,
+                "the absolute conic must be nondegenerate");
+
+  template <typename T> using Point = BasicCKPoint<CKGeometry, T>;
+  template <typename T> using Line = BasicCKLine<CKGeometry, T>;
+
+  /**
+   * @brief Polar line of a point
+   *
+   * @tparam T scalar
+   * @param[in] p
+   * @return std::array<T, 3>
+   */
+  template <typename T>
+  static constexpr auto point_perp(const std::array<T, 3> &p)
+      -> std::array<T, 3> {
+    return fun::detail::ck_apply<point_polar>(p);
+  }
+
+  /**
+   * @brief Pole of a line
+   *
+   * @tparam T scalar
+   * @param[in] l
+   * @return std::array<T, 3>
+   */
+  template <typename T>
+  static constexpr auto line_perp(const std::array<T, 3> &l)
+      -> std::array<T, 3> {
+    return fun::detail::ck_apply<line_polar>(l);
+  }
+};
+
+/**
+ * @brief Point of a Cayley-Klein geometry
+ *
+ * @tparam Geom CKGeometry
+ * @tparam T scalar
+ */
+template <class Geom, typename T>
+class BasicCKPoint
+    : public PgObject<BasicCKPoint<Geom, T>, BasicCKLine<Geom, T>, T> {
+public:
+  using Geometry = Geom;
+
+  /**
+   * @brief Construct a new CK Point object
+   *
+   * @param[in] coord Homogeneous coordinate
+   */
+  constexpr explicit BasicCKPoint(std::array<T, 3> coord)
+      : PgObject<BasicCKPoint<Geom, T>, BasicCKLine<Geom, T>, T>{coord} {}
+
+  /**
+   * @brief Polar line
+   *
+   * @return BasicCKLine<Geom, T>
+   */
+  constexpr auto perp() const -> BasicCKLine<Geom, T> {
+    return BasicCKLine<Geom, T>{Geom::point_perp(this->coord)};
+  }
+};
+
+/**
+ * @brief Line of a Cayley-Klein geometry
+ *
+ * @tparam Geom CKGeometry
+ * @tparam T scalar
+ */
+template <class Geom, typename T>
+class BasicCKLine
+    : public PgObject<BasicCKLine<Geom, T>, BasicCKPoint<Geom, T>, T> {
+public:
+  using Geometry = Geom;
+
+  /**
+   * @brief Construct a new CK Line object
+   *
+   * @param[in] coord Homogeneous coordinate
+   */
+  constexpr explicit BasicCKLine(std::array<T, 3> coord)
+      : PgObject<BasicCKLine<Geom, T>, BasicCKPoint<Geom, T>, T>{coord} {}
+
+  /**
+   * @brief Pole
+   *
+   * @return BasicCKPoint<Geom, T>
+   */
+  constexpr auto perp() const -> BasicCKPoint<Geom, T> {
+    return BasicCKPoint<Geom, T>{Geom::line_perp(this->coord)};
+  }
+};
+
+namespace fun {
+
+/**
+ * @brief Polars (or poles) of a whole batch
+ *
+ * One pass over the columns with the conic's coefficients folded in.
+ *
+ * @tparam Geom CKGeometry
+ * @tparam T scalar
+ * @param[in] pts
+ * @return PgArray<BasicCKLine<Geom, T>>
+ */
+template <class Geom, typename T>
+auto perp(const PgArray<BasicCKPoint<Geom, T>> &pts)
+    -> PgArray<BasicCKLine<Geom, T>> {
+  auto res = PgArray<BasicCKLine<Geom, T>>(pts.size());
+  const auto a = pts.columns();
+  const auto c = res.columns();
+  detail::ck_apply_columns<Geom::point_polar>(a[0], a[1], a[2], c[0], c[1],
+                                            c[2], pts.size());
+  return res;
+}
+
+/**
+ * @brief Poles of a batch of lines
+ *
+ * @tparam Geom CKGeometry
+ * @tparam T scalar
+ * @param[in] lns
+ * @return PgArray<BasicCKPoint<Geom, T>>
+ */
+template <class Geom, typename T>
+auto perp(const PgArray<BasicCKLine<Geom, T>> &lns)
+    -> PgArray<BasicCKPoint<Geom, T>> {
+  auto res = PgArray<BasicCKPoint<Geom, T>>(lns.size());
+  const auto a = lns.columns();
+  const auto c = res.columns();
+  detail::ck_apply_columns<Geom::line_polar>(a[0], a[1], a[2], c[0], c[1],
+                                            c[2], lns.size());
+  return res;
+}
+
+} // namespace fun
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <array>
+#include <cassert>
+
+#include "pg_plane.hpp"
 
 #if __cpp_concepts >= 201907L
 #include "ck_concepts.hpp"
@@ -60,7 +63,7 @@ constexpr auto orthocenter(const std::array<P, 3> &tri) -> P {
  * @param[in] tri
  * @return std::arrary<L, 3>
  */
-template <class P, class L>
+template <class P, class L = typename P::Dual>
 #if __cpp_concepts >= 201907L
   requires CKPlanePrimDual<P, L>
 #endif
@@ -78,8 +81,9 @@ template <typename V, class P, class L = typename P::Dual>
 #if __cpp_concepts >= 201907L
   requires CKPlaneDual<V, P, L>
 #endif
-constexpr auto reflect(const P &origin, const L &mirror, const P &p) -> P {
-  return involution(mirror.perp(), mirror, p);
+constexpr auto reflect([[maybe_unused]] const P &origin, const L &mirror,
+                       const P &p) -> P {
+  return involution<V>(mirror.perp(), mirror, p);
 }
 
 /*
@@ -0,0 +1,302 @@
+#pragma once
+
+/** @file include/projgeom/ck_runtime.hpp
+ *  Cayley-Klein geometry whose absolute conic is only known at runtime,
+ *  with batch operations dispatched once per batch.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ck_geometry.hpp"
+#include "pg_array.hpp"
+#include "pg_object.hpp"
+#include "pg_simd.hpp"
+
+namespace fun {
+
+/**  Shape of a polarity matrix, which decides its batch kernel */
+enum class PolarKind {
+  Identity, //!< perp keeps the coordinates (elliptic)
+  Signs,    //!< diagonal of +-1: copies and negations (hyperbolic)
+  Diagonal, //!< one multiply per coordinate
+  General   //!< full 3x3 product (SIMD xform kernel)
+};
+
+namespace detail {
+
+using PolarKernel = void (*)(simd::ConstColumns a, const CKMatrix &m,
+                             simd::Columns c, std::size_t n);
+
+inline void polar_identity(simd::ConstColumns a, const CKMatrix & /*m*/,
+                           simd::Columns c, std::size_t n) {
+  for (std::size_t k = 0; k != 3; ++k) {
+    if (c[k] != a[k]) {
+      std::copy(a[k], a[k] + n, c[k]);
+    }
+  }
+}
+
+inline void polar_signs(simd::ConstColumns a, const CKMatrix &m,
+                        simd::Columns c, std::size_t n) {
+  for (std::size_t k = 0; k != 3; ++k) {
+    if (m[k][k] > 0) {
+      if (c[k] != a[k]) {
+        std::copy(a[k], a[k] + n, c[k]);
+      }
+    } else {
+      const auto *src = a[k];
+      auto *dst = c[k];
+      for (std::size_t i = 0; i != n; ++i) {
+        dst[i] = -src[i];
+      }
+    }
+  }
+}
+
+inline void polar_diagonal(simd::ConstColumns a, const CKMatrix &m,
+                           simd::Columns c, std::size_t n) {
+  for (std::size_t k = 0; k != 3; ++k) {
+    const auto d = m[k][k];
+    const auto *src = a[k];
+    auto *dst = c[k];
+    for (std::size_t i = 0; i != n; ++i) {
+      dst[i] = d * src[i];
+    }
+  }
+}
+
+inline void polar_general(simd::ConstColumns a, const CKMatrix &m,
+                          simd::Columns c, std::size_t n) {
+  simd::xform_batch(a, m, c, n);
+}
+
+inline auto polar_kind(const CKMatrix &m) -> PolarKind {
+  if (m[0][1] != 0 || m[0][2] != 0 || m[1][2] != 0) {
+    return PolarKind::General;
+  }
+  const auto unit = [](int64_t d) { return d == 1 || d == -1; };
+  if (m[0][0] == 1 && m[1][1] == 1 && m[2][2] == 1) {
+    return PolarKind::Identity;
+  }
+  if (unit(m[0][0]) && unit(m[1][1]) && unit(m[2][2])) {
+    return PolarKind::Signs;
+  }
+  return PolarKind::Diagonal;
+}
+
+inline auto polar_kernel(PolarKind kind) -> PolarKernel {
+  switch (kind) {
+  case PolarKind::Identity:
+    return polar_identity;
+  case PolarKind::Signs:
+    return polar_signs;
+  case PolarKind::Diagonal:
+    return polar_diagonal;
+  default:
+    return polar_general;
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Cayley-Klein geometry with a runtime absolute conic
+ *
+ * Holds the conic M (the point polarity p -> M p) and its normalized
+ * adjugate (the line polarity, as CKGeometry::line_polar). The shape of
+ * each matrix is classified once, at construction, and the batch
+ * operations call the matching kernel once per batch, so the per-element
+ * work is the same straight loop as for a compile-time geometry, with no
+ * per-element indirection. The objects are plain projective points and
+ * lines; the geometry is passed alongside them.
+ *
+ * @tparam P Point (e.g. PgPoint)
+ * @tparam L Line
+ */
+template <class P = PgPoint, class L = typename P::Dual>
+class CKRuntimeGeometry {
+  using T = typename P::value_type;
+
+  CKMatrix _point_polar;
+  CKMatrix _line_polar;
+  PolarKind _point_kind;
+  PolarKind _line_kind;
+  detail::PolarKernel _point_kernel;
+  detail::PolarKernel _line_kernel;
+
+public:
+  /**
+   * @brief Construct from a symmetric, nondegenerate conic matrix
+   *
+   * @param[in] conic
+   */
+  explicit CKRuntimeGeometry(const CKMatrix &conic)
+      : _point_polar{conic}, _line_polar{detail::ck_line_polar(conic)},
+        _point_kind{detail::polar_kind(_point_polar)},
+        _line_kind{detail::polar_kind(_line_polar)},
+        _point_kernel{detail::polar_kernel(_point_kind)},
+        _line_kernel{detail::polar_kernel(_line_kind)} {
+    assert(conic[0][1] == conic[1][0] && conic[0][2] == conic[2][0] &&
+           conic[1][2] == conic[2][1]);
+    assert(::dot(conic[0], ::cross(conic[1], conic[2])) != 0);
+  }
+
+  /**
+   * @brief Construct from a compile-time geometry
+   *
+   * @tparam M conic
+   */
+  template <CKMatrix M>
+  explicit CKRuntimeGeometry(CKGeometry<M> /*geom*/) : CKRuntimeGeometry(M) {}
+
+  /**
+   * @brief Matrix of the point polarity (the conic)
+   *
+   * @return const CKMatrix&
+   */
+  [[nodiscard]] auto point_polar() const noexcept -> const CKMatrix & {
+    return this->_point_polar;
+  }
+
+  /**
+   * @brief Matrix of the line polarity
+   *
+   * @return const CKMatrix&
+   */
+  [[nodiscard]] auto line_polar() const noexcept -> const CKMatrix & {
+    return this->_line_polar;
+  }
+
+  /**
+   * @brief Kernel selected for points
+   *
+   * @return PolarKind
+   */
+  [[nodiscard]] auto point_kind() const noexcept -> PolarKind {
+    return this->_point_kind;
+  }
+
+  /**
+   * @brief Kernel selected for lines
+   *
+   * @return PolarKind
+   */
+  [[nodiscard]] auto line_kind() const noexcept -> PolarKind {
+    return this->_line_kind;
+  }
+
+  /**
+   * @brief Polar line of a point
+   *
+   * @param[in] p
+   * @return L
+   */
+  [[nodiscard]] auto perp(const P &p) const -> L {
+    return L{CKRuntimeGeometry::apply(this->_point_polar, p.coord)};
+  }
+
+  /**
+   * @brief Pole of a line
+   *
+   * @param[in] l
+   * @return P
+   */
+  [[nodiscard]] auto perp(const L &l) const -> P {
+    return P{CKRuntimeGeometry::apply(this->_line_polar, l.coord)};
+  }
+
+  /**
+   * @brief Polars of a batch of points
+   *
+   * @param[in] pts
+   * @return PgArray<L>
+   */
+  [[nodiscard]] auto perp(const PgArray<P> &pts) const -> PgArray<L> {
+    auto res = PgArray<L>(pts.size());
+    CKRuntimeGeometry::apply(this->_point_kernel, this->_point_polar, pts,
+                             res);
+    return res;
+  }
+
+  /**
+   * @brief Poles of a batch of lines
+   *
+   * @param[in] lns
+   * @return PgArray<P>
+   */
+  [[nodiscard]] auto perp(const PgArray<L> &lns) const -> PgArray<P> {
+    auto res = PgArray<P>(lns.size());
+    CKRuntimeGeometry::apply(this->_line_kernel, this->_line_polar, lns, res);
+    return res;
+  }
+
+  /**
+   * @brief Whether two lines are perpendicular
+   *
+   * @param[in] m1
+   * @param[in] m2
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto is_perpendicular(const L &m1, const L &m2) const
+      -> bool {
+    return this->perp(m1).incident(m2);
+  }
+
+  /**
+   * @brief Altitude from p to the line m
+   *
+   * @param[in] p
+   * @param[in] m
+   * @return L
+   */
+  [[nodiscard]] auto altitude(const P &p, const L &m) const -> L {
+    return this->perp(m).circ(p);
+  }
+
+  /**
+   * @brief Altitudes from pts[i] to lns[i]: one pole batch and one cross
+   *        batch
+   *
+   * @param[in] pts
+   * @param[in] lns
+   * @return PgArray<L>
+   */
+  [[nodiscard]] auto altitude(const PgArray<P> &pts,
+                              const PgArray<L> &lns) const -> PgArray<L> {
+    return this->perp(lns).circ(pts);
+  }
+
+private:
+  static auto apply(const CKMatrix &m, const std::array<T, 3> &v)
+      -> std::array<T, 3> {
+    const auto row = [&](std::size_t i) {
+      return T(m[i][0]) * v[0] + T(m[i][1]) * v[1] + T(m[i][2]) * v[2];
+    };
+    return {row(0), row(1), row(2)};
+  }
+
+  template <class Src, class Dst>
+  static void apply(detail::PolarKernel kernel, const CKMatrix &m,
+                    const PgArray<Src> &objs, PgArray<Dst> &out) {
+    const auto a = objs.columns();
+    const auto c = out.columns();
+    if constexpr (std::is_same_v<T, int64_t>) {
+      kernel({a[0], a[1], a[2]}, m, c, objs.size());
+    } else {
+      for (std::size_t i = 0; i != objs.size(); ++i) {
+        const auto v = CKRuntimeGeometry::apply(m, {a[0][i], a[1][i], a[2][i]});
+        c[0][i] = v[0];
+        c[1][i] = v[1];
+        c[2][i] = v[2];
+      }
+    }
+  }
+};
+
+} // namespace fun
@@ -0,0 +1,290 @@
+#pragma once
+
+/** @file include/projgeom/collinear.hpp
+ *  Maximal collinear subsets of a point set (or, dually, concurrent
+ *  bundles of a line set) in expected O(n^2) time via hashed joins.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "canonical.hpp"
+#include "parallel.hpp"
+#include "pg_array.hpp"
+#include "pg_simd.hpp"
+
+namespace fun {
+
+/**
+ * @brief Groups of three or more incident objects, with their carriers
+ *
+ * Group k consists of members[offsets[k] .. offsets[k + 1]) (indices into
+ * the input, in increasing order), all incident with carriers[k] (in
+ * canonical form). Groups are ordered by their first two members.
+ *
+ * @tparam C Carrier (a line for collinear points)
+ */
+template <class C> struct IncidenceGroups {
+  std::vector<C> carriers;
+  std::vector<std::size_t> offsets{0};
+  std::vector<uint32_t> members;
+  std::size_t degenerate_pairs{}; //!< pairs of equal (or zero) inputs
+
+  /**
+   * @brief Number of groups
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return this->carriers.size();
+  }
+
+  /**
+   * @brief Members of group k
+   *
+   * @param[in] k
+   * @return std::span<const uint32_t>
+   */
+  [[nodiscard]] auto group(std::size_t k) const -> std::span<const uint32_t> {
+    return {this->members.data() + this->offsets[k],
+            this->offsets[k + 1] - this->offsets[k]};
+  }
+};
+
+namespace detail {
+
+/**
+ * @brief Hash map split into independently locked shards
+ *
+ * @tparam K key with std::hash
+ * @tparam V
+ */
+template <class K, class V> class ShardedMap {
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<K, V> map;
+  };
+  std::vector<Shard> _shards;
+
+public:
+  explicit ShardedMap(std::size_t num_shards) : _shards(num_shards) {}
+
+  /**
+   * @brief Insert (key, value), or merge(existing, value) under the lock
+   *        of the key's shard if the key is present
+   */
+  template <class Merge>
+  void upsert(const K &key, std::size_t hash, V &&value, Merge &&merge) {
+    auto &sh = this->_shards[(hash >> 32) % this->_shards.size()];
+    std::lock_guard<std::mutex> lock(sh.mutex);
+    const auto [it, fresh] = sh.map.try_emplace(key, std::move(value));
+    if (!fresh) {
+      merge(it->second, std::move(value));
+    }
+  }
+
+  /**
+   * @brief Visit every entry (not thread-safe)
+   */
+  template <class Fn> void for_each(Fn &&fn) {
+    for (auto &sh : this->_shards) {
+      for (auto &[key, value] : sh.map) {
+        fn(key, value);
+      }
+    }
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief All maximal subsets of three or more collinear points
+ *
+ * For every anchor i (in parallel), the joins of i with the later points
+ * j > i are computed in one SIMD batch (int64), canonicalized and grouped
+ * in a per-thread open-addressing table; each line carrying two or more
+ * of them is then offered to a sharded concurrent map keyed by the
+ * canonical line. A line is found from each of its points but the last
+ * two; the map keeps the offer with the smallest anchor, which is the
+ * only complete one. Time is expected O(n^2), memory O(n) per thread plus
+ * the output. Points are assumed projectively distinct: equal points join
+ * to the zero line and are counted in degenerate_pairs.
+ *
+ * int64 coordinates below 2^31 in magnitude take the SIMD kernel; larger
+ * ones fall back to the exact canonical_cross(), which requires every
+ * join to fit in int64 once reduced (asserted).
+ *
+ * @tparam P Point (or Line, see concurrent_groups) with integer coordinates
+ * @param[in] pts
+ * @param[in] num_threads (0: default_concurrency())
+ * @return IncidenceGroups<typename P::Dual>
+ */
+template <class P>
+auto collinear_groups(const std::vector<P> &pts, unsigned num_threads = 0)
+    -> IncidenceGroups<typename P::Dual> {
+  using L = typename P::Dual;
+  using T = typename P::value_type;
+  using Key = Canonical<L>;
+  struct Offer {
+    uint32_t anchor;
+    std::vector<uint32_t> members;
+  };
+  constexpr auto none = ~uint32_t(0);
+
+  const auto n = pts.size();
+  if (num_threads == 0) {
+    num_threads = default_concurrency();
+  }
+  const auto cols = PgArray<P>(pts);
+  auto table = detail::ShardedMap<Key, Offer>(std::size_t(num_threads) * 16);
+  std::mutex mutex;
+  std::size_t degenerate = 0;
+
+  parallel_for(
+      n,
+      [&](std::size_t begin, std::size_t end) {
+        std::array<std::vector<T>, 3> buf;
+        for (auto &col : buf) {
+          col.resize(n);
+        }
+        auto mask = std::size_t(1);
+        while (mask < 2 * n) {
+          mask <<= 1;
+        }
+        --mask;
+        std::vector<uint32_t> slots(mask + 1); // local id + 1, 0 = empty
+        std::vector<Key> keys;
+        std::vector<std::size_t> hashes; // also locates the slot of each key
+        std::vector<uint32_t> count;
+        std::vector<uint32_t> id_of(n);
+        std::vector<std::vector<uint32_t>> groups;
+        std::size_t zeros = 0;
+
+        for (auto i = begin; i != end; ++i) {
+          const auto lo = i + 1;
+          const auto m = n - lo;
+          if (m < 2) {
+            continue;
+          }
+          if constexpr (std::is_same_v<T, int64_t>) {
+            const auto a = cols.columns();
+            exact_cross_batch({a[0] + lo, a[1] + lo, a[2] + lo},
+                              pts[i].coord,
+                              {buf[0].data(), buf[1].data(), buf[2].data()},
+                              m);
+          } else {
+            for (std::size_t t = 0; t != m; ++t) {
+              const auto c = ::cross(pts[lo + t].coord, pts[i].coord);
+              for (std::size_t k = 0; k != 3; ++k) {
+                buf[k][t] = c[k];
+              }
+            }
+          }
+
+          for (const auto hash : hashes) { // clear only the slots in use
+            for (auto h = hash & mask; slots[h] != 0; h = (h + 1) & mask) {
+              slots[h] = 0;
+            }
+          }
+          keys.clear();
+          hashes.clear();
+          count.clear();
+          for (std::size_t t = 0; t != m; ++t) {
+            const auto ln = L({buf[0][t], buf[1][t], buf[2][t]});
+            if (ln.coord == std::array<T, 3>{}) {
+              ++zeros;
+              id_of[t] = none;
+              continue;
+            }
+            const auto key = Key{ln};
+            const auto hash = key.hash();
+            auto h = hash & mask;
+            while (slots[h] != 0 && keys[slots[h] - 1] != key) {
+              h = (h + 1) & mask;
+            }
+            if (slots[h] == 0) {
+              keys.push_back(key);
+              hashes.push_back(hash);
+              count.push_back(0);
+              slots[h] = uint32_t(keys.size());
+            }
+            id_of[t] = slots[h] - 1;
+            ++count[id_of[t]];
+          }
+
+          // lines through i and at least two later points
+          groups.assign(keys.size(), {});
+          for (std::size_t t = 0; t != m; ++t) {
+            const auto id = id_of[t];
+            if (id == none || count[id] < 2) {
+              continue;
+            }
+            if (groups[id].empty()) {
+              groups[id].push_back(uint32_t(i));
+            }
+            groups[id].push_back(uint32_t(lo + t));
+          }
+          for (std::size_t id = 0; id != keys.size(); ++id) {
+            if (groups[id].empty()) {
+              continue;
+            }
+            table.upsert(keys[id], hashes[id],
+                         Offer{uint32_t(i), std::move(groups[id])},
+                         [](Offer &cur, Offer &&offer) {
+                           if (offer.anchor < cur.anchor) {
+                             cur = std::move(offer);
+                           }
+                         });
+          }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        degenerate += zeros;
+      },
+      0, num_threads);
+
+  std::vector<std::pair<const Key *, std::vector<uint32_t> *>> found;
+  table.for_each([&](const Key &key, Offer &offer) {
+    found.push_back({&key, &offer.members});
+  });
+  std::sort(found.begin(), found.end(), [](const auto &a, const auto &b) {
+    return std::pair{(*a.second)[0], (*a.second)[1]} <
+           std::pair{(*b.second)[0], (*b.second)[1]};
+  });
+
+  auto res = IncidenceGroups<L>{};
+  res.degenerate_pairs = degenerate;
+  res.carriers.reserve(found.size());
+  res.offsets.reserve(found.size() + 1);
+  for (const auto &[key, members] : found) {
+    res.carriers.push_back(key->get());
+    res.members.insert(res.members.end(), members->begin(), members->end());
+    res.offsets.push_back(res.members.size());
+  }
+  return res;
+}
+
+/**
+ * @brief All maximal bundles of three or more concurrent lines
+ *
+ * The dual of collinear_groups(); the carriers are the common points.
+ *
+ * @tparam L Line with integer coordinates
+ * @param[in] lns
+ * @param[in] num_threads (0: default_concurrency())
+ * @return IncidenceGroups<typename L::Dual>
+ */
+template <class L>
+auto concurrent_groups(const std::vector<L> &lns, unsigned num_threads = 0)
+    -> IncidenceGroups<typename L::Dual> {
+  return collinear_groups(lns, num_threads);
+}
+
+} // namespace fun
@@ -0,0 +1,465 @@
+#pragma once
+
+/** @file include/projgeom/construction.hpp
+ *  Dynamic-geometry constructions: a DAG of derived points and lines that
+ *  is brought up to date incrementally when its free objects move.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "pg_object.hpp"
+#include "pg_plane.hpp"
+
+#if __cpp_concepts >= 201907L
+#include "ck_concepts.hpp"
+#endif
+
+namespace fun {
+
+/**  Operation of a construction node */
+enum class ConstructOp : uint8_t {
+  Free,       //!< base object, set with move()
+  Circ,       //!< join of two points or meet of two lines
+  Polar,      //!< polar line of a point
+  Pole,       //!< pole of a line
+  Altitude,   //!< altitude from a point to a line
+  HarmConj,   //!< harmonic conjugate
+  Involution, //!< involution (origin, mirror) of a point
+  Reflect     //!< reflection of a point in a mirror
+};
+
+/**
+ * @brief Construction graph over the operations of pg_plane.hpp and
+ *        ck_plane.hpp
+ *
+ * Every object is a node holding its operation, its inputs and its
+ * current coordinates (in SoA columns, indexed by node id). Nodes can only
+ * depend on earlier nodes, so the ids are already a topological order; a
+ * node's level is one more than the highest level of its inputs. Moving a
+ * free object only marks it; update() then walks the dependents of the
+ * moved objects once, buckets the reached nodes by (level, operation),
+ * and recomputes each bucket in one straight loop, level by level. A frame
+ * in which one base point moves therefore costs only its downstream cone,
+ * with one dispatch per bucket instead of one per node and no allocation
+ * once the buffers have grown.
+ *
+ * The perp based operations (Polar, Pole, Altitude, Reflect) need a
+ * Cayley-Klein point type; the others work in any projective plane.
+ *
+ * @tparam P Point
+ * @tparam L Line
+ */
+template <class P, class L = typename P::Dual> class Construction {
+  using T = typename P::value_type;
+
+  static constexpr bool has_perp = requires(const P &p, const L &l) {
+    p.perp();
+    l.perp();
+  };
+
+  struct Node {
+    ConstructOp op;
+    uint32_t level;
+    std::array<uint32_t, 3> in;
+  };
+
+  std::vector<Node> _nodes;
+  std::array<std::vector<T>, 3> _coord;
+  std::vector<std::vector<uint32_t>> _users;
+  std::vector<uint32_t> _group;            // (level, op) bucket of each node
+  std::vector<std::vector<uint32_t>> _due; // nodes to recompute, per bucket
+  std::vector<std::pair<uint32_t, ConstructOp>> _groups;
+  std::vector<uint32_t> _moved;
+  std::vector<uint32_t> _mark; // _epoch if already scheduled in this update
+  std::vector<uint32_t> _stack;
+  uint32_t _epoch{};
+  bool _stale{};
+
+public:
+  /**  Handle of a point node */
+  struct PointId {
+    uint32_t id;
+  };
+
+  /**  Handle of a line node */
+  struct LineId {
+    uint32_t id;
+  };
+
+  /**
+   * @brief Number of nodes
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return this->_nodes.size();
+  }
+
+  /**
+   * @brief Level of a node (0 for free objects)
+   *
+   * @param[in] id
+   * @return uint32_t
+   */
+  [[nodiscard]] auto level(uint32_t id) const -> uint32_t {
+    return this->_nodes[id].level;
+  }
+
+  /**
+   * @brief Current coordinates of a point
+   *
+   * @param[in] p
+   * @return P
+   */
+  auto operator[](PointId p) const -> P { return this->load<P>(p.id); }
+
+  /**
+   * @brief Current coordinates of a line
+   *
+   * @param[in] l
+   * @return L
+   */
+  auto operator[](LineId l) const -> L { return this->load<L>(l.id); }
+
+  /**
+   * @brief Add a free point
+   *
+   * @param[in] p
+   * @return PointId
+   */
+  auto point(const P &p) -> PointId {
+    return {this->add(ConstructOp::Free, {}, 0, p.coord)};
+  }
+
+  /**
+   * @brief Add a free line
+   *
+   * @param[in] l
+   * @return LineId
+   */
+  auto line(const L &l) -> LineId {
+    return {this->add(ConstructOp::Free, {}, 0, l.coord)};
+  }
+
+  /**
+   * @brief Add the line through two points
+   *
+   * @param[in] p
+   * @param[in] q
+   * @return LineId
+   */
+  auto join(PointId p, PointId q) -> LineId {
+    return {this->derive(ConstructOp::Circ, {p.id, q.id}, 2)};
+  }
+
+  /**
+   * @brief Add the point where two lines meet
+   *
+   * @param[in] l
+   * @param[in] m
+   * @return PointId
+   */
+  auto meet(LineId l, LineId m) -> PointId {
+    return {this->derive(ConstructOp::Circ, {l.id, m.id}, 2)};
+  }
+
+  /**
+   * @brief Add the polar line of a point
+   *
+   * @param[in] p
+   * @return LineId
+   */
+  auto perp(PointId p) -> LineId
+#if __cpp_concepts >= 201907L
+    requires CKPlanePrimDual<P, L>
+#endif
+  {
+    return {this->derive(ConstructOp::Polar, {p.id}, 1)};
+  }
+
+  /**
+   * @brief Add the pole of a line
+   *
+   * @param[in] l
+   * @return PointId
+   */
+  auto perp(LineId l) -> PointId
+#if __cpp_concepts >= 201907L
+    requires CKPlanePrimDual<P, L>
+#endif
+  {
+    return {this->derive(ConstructOp::Pole, {l.id}, 1)};
+  }
+
+  /**
+   * @brief Add the altitude from p to m
+   *
+   * @param[in] p
+   * @param[in] m
+   * @return LineId
+   */
+  auto altitude(PointId p, LineId m) -> LineId
+#if __cpp_concepts >= 201907L
+    requires CKPlanePrimDual<P, L>
+#endif
+  {
+    return {this->derive(ConstructOp::Altitude, {p.id, m.id}, 2)};
+  }
+
+  /**
+   * @brief Add the harmonic conjugate of c with respect to a and b
+   *
+   * @param[in] a
+   * @param[in] b
+   * @param[in] c
+   * @return PointId
+   */
+  auto harm_conj(PointId a, PointId b, PointId c) -> PointId {
+    return {this->derive(ConstructOp::HarmConj, {a.id, b.id, c.id}, 3)};
+  }
+
+  /**
+   * @brief Add the image of p under the involution (origin, mirror)
+   *
+   * @param[in] origin
+   * @param[in] mirror
+   * @param[in] p
+   * @return PointId
+   */
+  auto involution(PointId origin, LineId mirror, PointId p) -> PointId {
+    return {this->derive(ConstructOp::Involution, {origin.id, mirror.id, p.id},
+                         3)};
+  }
+
+  /**
+   * @brief Add the reflection of p in mirror
+   *
+   * @param[in] mirror
+   * @param[in] p
+   * @return PointId
+   */
+  auto reflect(LineId mirror, PointId p) -> PointId
+#if __cpp_concepts >= 201907L
+    requires CKPlanePrimDual<P, L>
+#endif
+  {
+    return {this->derive(ConstructOp::Reflect, {mirror.id, p.id}, 2)};
+  }
+
+  /**
+   * @brief Move a free point; dependents are recomputed by update()
+   *
+   * @param[in] p
+   * @param[in] value
+   */
+  void move(PointId p, const P &value) { this->set_free(p.id, value.coord); }
+
+  /**
+   * @brief Move a free line; dependents are recomputed by update()
+   *
+   * @param[in] l
+   * @param[in] value
+   */
+  void move(LineId l, const L &value) { this->set_free(l.id, value.coord); }
+
+  /**
+   * @brief Recompute every node downstream of the objects moved since the
+   *        last update
+   *
+   * @return std::size_t number of nodes recomputed
+   */
+  auto update() -> std::size_t {
+    if (this->_moved.empty()) {
+      return 0;
+    }
+    if (this->_stale) {
+      this->regroup();
+    }
+    if (++this->_epoch == 0) { // wrapped: forget all old marks
+      std::fill(this->_mark.begin(), this->_mark.end(), 0);
+      this->_epoch = 1;
+    }
+
+    // the downstream cone of the moved objects, bucketed by (level, op)
+    std::size_t count = 0;
+    auto &stack = this->_stack;
+    for (const auto id : this->_moved) {
+      stack.push_back(id);
+    }
+    this->_moved.clear();
+    while (!stack.empty()) {
+      const auto id = stack.back();
+      stack.pop_back();
+      for (const auto user : this->_users[id]) {
+        if (this->_mark[user] != this->_epoch) {
+          this->_mark[user] = this->_epoch;
+          this->_due[this->_group[user]].push_back(user);
+          stack.push_back(user);
+          ++count;
+        }
+      }
+    }
+
+    // buckets are sorted by level, so inputs are always recomputed first
+    for (std::size_t g = 0; g != this->_groups.size(); ++g) {
+      auto &due = this->_due[g];
+      if (!due.empty()) {
+        this->recompute(this->_groups[g].second, due);
+        due.clear();
+      }
+    }
+    return count;
+  }
+
+private:
+  auto coords(uint32_t id) const -> std::array<T, 3> {
+    return {this->_coord[0][id], this->_coord[1][id], this->_coord[2][id]};
+  }
+
+  template <class O> auto load(uint32_t id) const -> O {
+    return O{this->coords(id)};
+  }
+
+  void store(uint32_t id, const std::array<T, 3> &v) {
+    this->_coord[0][id] = v[0];
+    this->_coord[1][id] = v[1];
+    this->_coord[2][id] = v[2];
+  }
+
+  auto add(ConstructOp op, const std::array<uint32_t, 3> &in,
+           uint32_t level, const std::array<T, 3> &v) -> uint32_t {
+    const auto id = uint32_t(this->_nodes.size());
+    this->_nodes.push_back({op, level, in});
+    for (std::size_t k = 0; k != 3; ++k) {
+      this->_coord[k].push_back(v[k]);
+    }
+    this->_users.emplace_back();
+    this->_group.push_back(0);
+    this->_mark.push_back(0);
+    this->_stale = true;
+    return id;
+  }
+
+  auto derive(ConstructOp op, std::array<uint32_t, 3> in, std::size_t arity)
+      -> uint32_t {
+    auto level = uint32_t(0);
+    for (std::size_t k = 0; k != arity; ++k) {
+      assert(in[k] < this->_nodes.size());
+      level = std::max(level, this->_nodes[in[k]].level + 1);
+    }
+    const auto id = this->add(op, in, level, {});
+    for (std::size_t k = 0; k != arity; ++k) {
+      this->_users[in[k]].push_back(id); // repeats are marked only once
+    }
+    this->recompute(op, std::vector<uint32_t>{id});
+    return id;
+  }
+
+  void set_free(uint32_t id, const std::array<T, 3> &v) {
+    assert(this->_nodes[id].op == ConstructOp::Free);
+    this->store(id, v);
+    this->_moved.push_back(id);
+  }
+
+  void regroup() {
+    this->_groups.clear();
+    for (const auto &node : this->_nodes) {
+      this->_groups.emplace_back(node.level, node.op);
+    }
+    std::sort(this->_groups.begin(), this->_groups.end());
+    this->_groups.erase(
+        std::unique(this->_groups.begin(), this->_groups.end()),
+        this->_groups.end());
+    for (std::size_t id = 0; id != this->_nodes.size(); ++id) {
+      const auto key = std::pair{this->_nodes[id].level, this->_nodes[id].op};
+      this->_group[id] = uint32_t(
+          std::lower_bound(this->_groups.begin(), this->_groups.end(), key) -
+          this->_groups.begin());
+    }
+    this->_due.resize(this->_groups.size());
+    this->_stale = false;
+  }
+
+  // one loop per operation: the dispatch is per bucket, not per node
+  void recompute(ConstructOp op, const std::vector<uint32_t> &ids) {
+    const auto &nodes = this->_nodes;
+    switch (op) {
+    case ConstructOp::Free:
+      break;
+    case ConstructOp::Circ:
+      for (const auto id : ids) {
+        const auto &in = nodes[id].in;
+        this->store(id, ::cross(this->coords(in[0]), this->coords(in[1])));
+      }
+      break;
+    case ConstructOp::Polar:
+    case ConstructOp::Pole:
+    case ConstructOp::Altitude:
+    case ConstructOp::Reflect:
+      if constexpr (has_perp) {
+        this->recompute_ck(op, ids);
+      }
+      break;
+    case ConstructOp::HarmConj:
+      for (const auto id : ids) {
+        const auto &in = nodes[id].in;
+        this->store(id, fun::harm_conj<T>(this->load<P>(in[0]),
+                                          this->load<P>(in[1]),
+                                          this->load<P>(in[2]))
+                            .coord);
+      }
+      break;
+    case ConstructOp::Involution:
+      for (const auto id : ids) {
+        const auto &in = nodes[id].in;
+        this->store(id, fun::involution<T>(this->load<P>(in[0]),
+                                           this->load<L>(in[1]),
+                                           this->load<P>(in[2]))
+                            .coord);
+      }
+      break;
+    }
+  }
+
+  void recompute_ck(ConstructOp op, const std::vector<uint32_t> &ids) {
+    const auto &nodes = this->_nodes;
+    switch (op) {
+    case ConstructOp::Polar:
+      for (const auto id : ids) {
+        this->store(id, this->load<P>(nodes[id].in[0]).perp().coord);
+      }
+      break;
+    case ConstructOp::Pole:
+      for (const auto id : ids) {
+        this->store(id, this->load<L>(nodes[id].in[0]).perp().coord);
+      }
+      break;
+    case ConstructOp::Altitude:
+      for (const auto id : ids) {
+        const auto &in = nodes[id].in;
+        this->store(id, this->load<L>(in[1]).perp().circ(this->load<P>(in[0]))
+                            .coord);
+      }
+      break;
+    case ConstructOp::Reflect:
+      for (const auto id : ids) {
+        const auto &in = nodes[id].in;
+        const auto mirror = this->load<L>(in[0]);
+        this->store(id, fun::involution<T>(mirror.perp(), mirror,
+                                           this->load<P>(in[1]))
+                            .coord);
+      }
+      break;
+    default:
+      break;
+    }
+  }
+};
+
+} // namespace fun
@@ -1,69 +1,27 @@
 #pragma once
 
-#include "ck_plane.hpp"
-#include "pg_object.hpp"
-
-class EllPoint;
-class EllLine;
+#include "ck_geometry.hpp"
 
 /**
- * @brief Elliptic Point
+ * @brief Elliptic geometry: the (imaginary) conic x^2 + y^2 + z^2 = 0
  *
+ * perp keeps the coordinates.
  */
-class EllPoint : public PgObject<EllPoint, EllLine> {
-public:
-  /**
-   * @brief Construct a new Ell Point object
-   *
-   * @param[in] coord Homogeneous coordinate
-   */
-  constexpr explicit EllPoint(std::array<int64_t, 3> coord)
-      : PgObject<EllPoint, EllLine>{coord} {}
-
-  /**
-   * @brief
-   *
-   * @return EllLine
-   */
-  constexpr auto perp() const -> EllLine;
-};
+using EllGeometry = CKGeometry<ck_diagonal(1, 1, 1)>;
 
 /**
- * @brief Elliptic Line
+ * @brief Elliptic Point
  *
+ * @tparam T scalar
  */
-class EllLine : public PgObject<EllLine, EllPoint> {
-public:
-  /**
-   * @brief Construct a new Ell Line object
-   *
-   * @param[in] coord Homogeneous coordinate
-   */
-  constexpr explicit EllLine(std::array<int64_t, 3> coord)
-      : PgObject<EllLine, EllPoint>{coord} {}
-
-  /**
-   * @brief
-   *
-   * @return EllPoint
-   */
-  constexpr auto perp() const -> EllPoint;
-};
+template <typename T> using BasicEllPoint = EllGeometry::Point<T>;
 
 /**
- * @brief
+ * @brief Elliptic Line
  *
- * @return EllLine
+ * @tparam T scalar
  */
-inline constexpr auto EllPoint::perp() const -> EllLine {
-  return EllLine{this->coord};
-}
+template <typename T> using BasicEllLine = EllGeometry::Line<T>;
 
-/**
- * @brief
- *
- * @return EllPoint
- */
-inline constexpr auto EllLine::perp() const -> EllPoint {
-  return EllPoint{this->coord};
-}
+using EllPoint = BasicEllPoint<int64_t>;
+using EllLine = BasicEllLine<int64_t>;
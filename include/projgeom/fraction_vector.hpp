@@ -0,0 +1,236 @@
+// -*- coding: utf-16 -*-
+#pragma once
+
+/** @file include/projgeom/fraction_vector.hpp
+ *  Vector of fractions sharing one denominator.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "fractions.hpp"
+
+namespace fun {
+
+/**
+ * @brief Vector of fractions with a common denominator
+ *
+ * Element i is num(i) / den(). Bulk add, scale and dot rescale the shared
+ * denominator once per call instead of doing a gcd per element as
+ * Fraction::operator+ does. The numerators are not reduced against the
+ * denominator until normalize() is called.
+ *
+ * @tparam Z
+ */
+template <Integral Z> class FractionVector {
+  std::vector<Z> _nums;
+  Z _den{1};
+
+  // lcm(a, b) for positive a and b, with the two cofactors l/a and l/b
+  static constexpr auto lcm_factors(const Z &a, const Z &b)
+      -> std::pair<Z, Z> {
+    const auto g = gcd(a, b);
+    return {b / g, a / g};
+  }
+
+public:
+  /**
+   * @brief Construct a new Fraction Vector object
+   *
+   * @param[in] n number of (zero) elements
+   */
+  explicit FractionVector(std::size_t n = 0) : _nums(n, Z(0)) {}
+
+  /**
+   * @brief Construct a new Fraction Vector object
+   *
+   * @param[in] nums numerators
+   * @param[in] den common denominator (nonzero)
+   */
+  FractionVector(std::vector<Z> nums, Z den)
+      : _nums{std::move(nums)}, _den{std::move(den)} {
+    assert(this->_den != Z(0));
+    if (this->_den < Z(0)) {
+      this->_den = -this->_den;
+      for (auto &n : this->_nums) {
+        n = -n;
+      }
+    }
+  }
+
+  /**
+   * @brief Construct a new Fraction Vector object
+   *
+   * @param[in] fracs
+   */
+  explicit FractionVector(const std::vector<Fraction<Z>> &fracs)
+      : _nums(fracs.size()) {
+    for (const auto &frac : fracs) {
+      this->_den *= lcm_factors(this->_den, frac.den()).first;
+    }
+    for (std::size_t i = 0; i != fracs.size(); ++i) {
+      this->_nums[i] = fracs[i].num() * (this->_den / fracs[i].den());
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return this->_nums.size();
+  }
+
+  /**
+   * @brief Common denominator
+   *
+   * @return const Z&
+   */
+  [[nodiscard]] auto den() const noexcept -> const Z & { return this->_den; }
+
+  /**
+   * @brief Numerators
+   *
+   * @return const std::vector<Z>&
+   */
+  [[nodiscard]] auto nums() const noexcept -> const std::vector<Z> & {
+    return this->_nums;
+  }
+
+  /**
+   * @brief The i-th element in canonical form
+   *
+   * @param[in] i
+   * @return Fraction<Z>
+   */
+  [[nodiscard]] auto operator[](std::size_t i) const -> Fraction<Z> {
+    return Fraction<Z>(this->_nums[i], this->_den);
+  }
+
+  /**
+   * @brief Divide the numerators and the denominator by their common gcd
+   *
+   * @return Z the common factor removed
+   */
+  auto normalize() -> Z {
+    auto common = this->_den;
+    for (const auto &n : this->_nums) {
+      if (common == Z(1)) {
+        return common;
+      }
+      common = gcd(common, n);
+    }
+    if (common != Z(1)) {
+      this->_den /= common;
+      for (auto &n : this->_nums) {
+        n /= common;
+      }
+    }
+    return common;
+  }
+
+  /**
+   * @brief Element-wise add
+   *
+   * @param[in] rhs
+   * @return FractionVector&
+   */
+  auto operator+=(const FractionVector &rhs) -> FractionVector & {
+    assert(this->size() == rhs.size());
+    if (this->_den == rhs._den) {
+      for (std::size_t i = 0; i != this->size(); ++i) {
+        this->_nums[i] += rhs._nums[i];
+      }
+      return *this;
+    }
+    const auto [fl, fr] = lcm_factors(this->_den, rhs._den);
+    for (std::size_t i = 0; i != this->size(); ++i) {
+      this->_nums[i] = this->_nums[i] * fl + rhs._nums[i] * fr;
+    }
+    this->_den *= fl;
+    return *this;
+  }
+
+  /**
+   * @brief Element-wise subtract
+   *
+   * @param[in] rhs
+   * @return FractionVector&
+   */
+  auto operator-=(const FractionVector &rhs) -> FractionVector & {
+    assert(this->size() == rhs.size());
+    if (this->_den == rhs._den) {
+      for (std::size_t i = 0; i != this->size(); ++i) {
+        this->_nums[i] -= rhs._nums[i];
+      }
+      return *this;
+    }
+    const auto [fl, fr] = lcm_factors(this->_den, rhs._den);
+    for (std::size_t i = 0; i != this->size(); ++i) {
+      this->_nums[i] = this->_nums[i] * fl - rhs._nums[i] * fr;
+    }
+    this->_den *= fl;
+    return *this;
+  }
+
+  /**
+   * @brief Scale every element
+   *
+   * @param[in] alpha
+   * @return FractionVector&
+   */
+  auto operator*=(const Fraction<Z> &alpha) -> FractionVector & {
+    // alpha is reduced, so only its numerator can share a factor with _den
+    const auto g = gcd(alpha.num(), this->_den); // _den > 0, so g > 0
+    const auto mul = alpha.num() / g;
+    this->_den /= g;
+    for (auto &n : this->_nums) {
+      n *= mul;
+    }
+    this->_den *= alpha.den();
+    return *this;
+  }
+
+  /**
+   * @brief Scale every element
+   *
+   * @param[in] alpha
+   * @return FractionVector&
+   */
+  auto operator*=(const Z &alpha) -> FractionVector & {
+    return *this *= Fraction<Z>(alpha);
+  }
+
+  friend auto operator+(FractionVector lhs, const FractionVector &rhs)
+      -> FractionVector {
+    return lhs += rhs;
+  }
+
+  friend auto operator-(FractionVector lhs, const FractionVector &rhs)
+      -> FractionVector {
+    return lhs -= rhs;
+  }
+
+  friend auto operator*(FractionVector lhs, const Fraction<Z> &alpha)
+      -> FractionVector {
+    return lhs *= alpha;
+  }
+
+  /**
+   * @brief Dot product
+   *
+   * The numerators are accumulated as integers; a single gcd reduces the
+   * result.
+   *
+   * @param[in] rhs
+   * @return Fraction<Z>
+   */
+  [[nodiscard]] auto dot(const FractionVector &rhs) const -> Fraction<Z> {
+    assert(this->size() == rhs.size());
+    auto sum = Z(0);
+    for (std::size_t i = 0; i != this->size(); ++i) {
+      sum += this->_nums[i] * rhs._nums[i];
+    }
+    return Fraction<Z>(sum, this->_den * rhs._den);
+  }
+};
+
+} // namespace fun
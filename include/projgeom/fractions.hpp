@@ -7,6 +7,11 @@
 
 // #include <boost/operators.hpp>
 // #include <cmath>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <numeric>
 #include <type_traits>
 #include <utility>
@@ -46,9 +51,111 @@ inline constexpr auto gcd_recur(const _Mn &__m, const _Mn &__n) -> _Mn {
   return gcd_recur(__n, __m % __n);
 }
 
+/**
+ * @brief Count trailing zeros (64 for x == 0)
+ *
+ * @param[in] x
+ * @return int
+ */
+inline constexpr auto ctz(uint64_t x) -> int { return std::countr_zero(x); }
+
+#ifdef __SIZEOF_INT128__
+/**
+ * @brief Count trailing zeros (128 for x == 0)
+ *
+ * @param[in] x
+ * @return int
+ */
+inline constexpr auto ctz(unsigned __int128 x) -> int {
+  const auto lo = static_cast<uint64_t>(x);
+  return lo != 0 ? ctz(lo) : 64 + ctz(static_cast<uint64_t>(x >> 64));
+}
+#endif
+
+/**
+ * @brief Unsigned/signed pair used by the binary gcd (void if not applicable)
+ */
+template <typename _Mn> struct binary_gcd_traits {
+  using type = void;
+  using signed_type = void;
+};
+template <> struct binary_gcd_traits<int32_t> {
+  using type = uint64_t;
+  using signed_type = int64_t;
+};
+template <> struct binary_gcd_traits<int64_t> {
+  using type = uint64_t;
+  using signed_type = int64_t;
+};
+#ifdef __SIZEOF_INT128__
+template <> struct binary_gcd_traits<__int128> {
+  using type = unsigned __int128;
+  using signed_type = __int128;
+};
+#endif
+
+/**
+ * @brief Binary (Stein) gcd of two magnitudes
+ *
+ * Uses only shifts, subtractions and ctz; no division. The difference is
+ * taken as a signed value so that its ctz overlaps with the min/abs of the
+ * next step. After the first shift both operands are odd, hence below the
+ * signed maximum even for a magnitude of INT64_MIN.
+ *
+ * @tparam _Mn signed integer selecting binary_gcd_traits
+ * @param[in] __u
+ * @param[in] __v
+ * @return unsigned magnitude of the gcd
+ */
+template <typename _Mn>
+inline constexpr auto gcd_binary_unsigned(
+    typename binary_gcd_traits<_Mn>::type __u,
+    typename binary_gcd_traits<_Mn>::type __v) ->
+    typename binary_gcd_traits<_Mn>::type {
+  using _Un = typename binary_gcd_traits<_Mn>::type;
+  using _Sn = typename binary_gcd_traits<_Mn>::signed_type;
+  if (__u == 0) {
+    return __v;
+  }
+  if (__v == 0) {
+    return __u;
+  }
+  auto __uz = ctz(__u);
+  const auto __vz = ctz(__v);
+  const auto __shift = std::min(__uz, __vz);
+  __v >>= __vz;
+  while (__u != 0) {
+    __u >>= __uz;
+    const auto __diff = _Sn(__v) - _Sn(__u);
+    __uz = ctz(_Un(__diff));
+    __v = std::min(__u, __v);
+    __u = _Un(__diff < 0 ? -__diff : __diff);
+  }
+  return __v << __shift;
+}
+
+/**
+ * @brief Greatest common divider (binary algorithm)
+ *
+ * @tparam _Mn int32_t, int64_t or __int128
+ * @param[in] __m
+ * @param[in] __n
+ * @return _Mn
+ */
+template <typename _Mn>
+inline constexpr auto gcd_binary(const _Mn &__m, const _Mn &__n) -> _Mn {
+  using _Un = typename binary_gcd_traits<_Mn>::type;
+  const auto __u = __m < 0 ? _Un(0) - _Un(__m) : _Un(__m);
+  const auto __v = __n < 0 ? _Un(0) - _Un(__n) : _Un(__n);
+  return static_cast<_Mn>(gcd_binary_unsigned<_Mn>(__u, __v));
+}
+
 /**
  * @brief Greatest common divider
  *
+ * Built-in signed integers use the division-free binary gcd; other
+ * integral types use Euclid's algorithm.
+ *
  * @tparam _Mn
  * @param[in] __m
  * @param[in] __n
@@ -56,10 +163,14 @@ inline constexpr auto gcd_recur(const _Mn &__m, const _Mn &__n) -> _Mn {
  */
 template <Integral _Mn>
 inline constexpr auto gcd(const _Mn &__m, const _Mn &__n) -> _Mn {
-  if (__m == 0) {
-    return abs(__n);
+  if constexpr (!std::is_void_v<typename binary_gcd_traits<_Mn>::type>) {
+    return gcd_binary(__m, __n);
+  } else {
+    if (__m == 0) {
+      return abs(__n);
+    }
+    return gcd_recur(__m, __n);
   }
-  return gcd_recur(__m, __n);
 }
 
 /**
@@ -78,6 +189,23 @@ inline constexpr auto lcm(const _Mn &__m, const _Mn &__n) -> _Mn {
   return (abs(__m) / gcd(__m, __n)) * abs(__n);
 }
 
+/**
+ * @brief Element-wise gcd of two arrays
+ *
+ * @tparam _Mn
+ * @param[in] __a
+ * @param[in] __b
+ * @param[out] __res may alias __a or __b
+ * @param[in] __n
+ */
+template <Integral _Mn>
+inline void gcd_batch(const _Mn *__a, const _Mn *__b, _Mn *__res,
+                      std::size_t __n) {
+  for (std::size_t __i = 0; __i != __n; ++__i) {
+    __res[__i] = gcd(__a[__i], __b[__i]);
+  }
+}
+
 /**
  * @brief Fraction
  *
@@ -746,6 +874,71 @@ template <Integral Z> struct Fraction {
   }
 };
 
+/**
+ * @brief Reduce an array of fractions to the canonical form
+ *
+ * Same result as calling normalize() on each element, with the gcds
+ * computed by gcd_batch.
+ *
+ * @tparam Z
+ * @param[in,out] fracs
+ * @param[in] n
+ */
+template <Integral Z> void normalize_batch(Fraction<Z> *fracs, std::size_t n) {
+  constexpr std::size_t chunk = 256;
+  Z nums[chunk];
+  Z dens[chunk];
+  Z common[chunk];
+  for (std::size_t i = 0; i < n; i += chunk) {
+    const auto m = std::min(chunk, n - i);
+    for (std::size_t k = 0; k != m; ++k) {
+      fracs[i + k].normalize1();
+      nums[k] = fracs[i + k]._num;
+      dens[k] = fracs[i + k]._den;
+    }
+    gcd_batch(nums, dens, common, m);
+    for (std::size_t k = 0; k != m; ++k) {
+      if (common[k] != Z(1) && common[k] != Z(0)) {
+        fracs[i + k]._num /= common[k];
+        fracs[i + k]._den /= common[k];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Divide each homogeneous triple by the gcd of its entries
+ *
+ * @tparam Z
+ * @param[in,out] triples
+ * @param[in] n
+ */
+template <Integral Z>
+void normalize_batch(std::array<Z, 3> *triples, std::size_t n) {
+  constexpr std::size_t chunk = 256;
+  Z xs[chunk];
+  Z ys[chunk];
+  Z zs[chunk];
+  Z common[chunk];
+  for (std::size_t i = 0; i < n; i += chunk) {
+    const auto m = std::min(chunk, n - i);
+    for (std::size_t k = 0; k != m; ++k) {
+      xs[k] = triples[i + k][0];
+      ys[k] = triples[i + k][1];
+      zs[k] = triples[i + k][2];
+    }
+    gcd_batch(xs, ys, common, m);
+    gcd_batch(common, zs, common, m);
+    for (std::size_t k = 0; k != m; ++k) {
+      if (common[k] != Z(1) && common[k] != Z(0)) {
+        for (auto &c : triples[i + k]) {
+          c /= common[k];
+        }
+      }
+    }
+  }
+}
+
 // For template deduction
 // Integral{Z} Fraction(const Z &, const Z &) noexcept -> Fraction<Z>;
 
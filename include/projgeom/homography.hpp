@@ -0,0 +1,411 @@
+#pragma once
+
+/** @file include/projgeom/homography.hpp
+ *  3x3 projective transformations (collineations) of the plane.
+ */
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "fractions.hpp"
+#include "pg_array.hpp"
+#include "pg_object.hpp"
+#include "pg_simd.hpp"
+#include "predicates.hpp"
+
+#if __cpp_concepts >= 201907L
+#include "ck_concepts.hpp"
+#include "pg_concepts.hpp"
+#endif
+
+namespace fun {
+
+/**
+ * @brief Projective transformation p -> M p
+ *
+ * Lines are mapped by the adjugate transpose adj(M)^T, which is the
+ * inverse transpose up to the factor det(M), so incidence is preserved
+ * without any division. Like points, homographies are only defined up to
+ * a nonzero factor: equality is proportionality, and integer matrices are
+ * divided by the gcd of their entries after composition.
+ *
+ * @tparam T scalar (integer, or e.g. Fraction for rational matrices)
+ */
+template <typename T> struct Homography {
+  using value_type = T;
+  using Matrix = std::array<std::array<T, 3>, 3>; // row-major
+
+  Matrix mat; //!< call reduce() after changing entries directly
+
+  /**
+   * @brief Construct a new Homography object
+   *
+   * @param[in] mat
+   */
+  constexpr explicit Homography(Matrix mat)
+      : mat{std::move(mat)}, _line{Homography::line_matrix(this->mat)} {}
+
+  /**
+   * @brief Identity transformation
+   *
+   * @return Homography
+   */
+  static constexpr auto identity() -> Homography {
+    return Homography{
+        {{{T(1), T(0), T(0)}, {T(0), T(1), T(0)}, {T(0), T(0), T(1)}}}};
+  }
+
+  /**
+   * @brief Homography with the given columns
+   *
+   * @param[in] c0
+   * @param[in] c1
+   * @param[in] c2
+   * @return Homography
+   */
+  static constexpr auto from_columns(const std::array<T, 3> &c0,
+                                     const std::array<T, 3> &c1,
+                                     const std::array<T, 3> &c2)
+      -> Homography {
+    return Homography{{{{c0[0], c1[0], c2[0]},
+                        {c0[1], c1[1], c2[1]},
+                        {c0[2], c1[2], c2[2]}}}};
+  }
+
+  /**
+   * @brief The transformation taking the four points src to dst
+   *
+   * Each frame p0..p3 is sent from the standard frame by S = [p0 p1 p2]
+   * diag(adj[p0 p1 p2] p3); then H = S_dst adj(S_src). Requires both
+   * quadruples in general position (no three collinear).
+   *
+   * @tparam P Point
+   * @param[in] src
+   * @param[in] dst
+   * @return Homography
+   */
+  template <class P>
+  static constexpr auto from_points(const std::array<P, 4> &src,
+                                    const std::array<P, 4> &dst)
+      -> Homography {
+    auto res = frame(dst) * frame(src).adjugate();
+    assert(res.det() != T(0));
+    return res;
+  }
+
+  /**
+   * @brief Determinant
+   *
+   * @return T
+   */
+  [[nodiscard]] constexpr auto det() const -> T {
+    return fun::det3(this->mat[0], this->mat[1], this->mat[2]);
+  }
+
+  /**
+   * @brief Adjugate, i.e. det(M) M^-1: the inverse transformation
+   *
+   * @return Homography
+   */
+  [[nodiscard]] constexpr auto adjugate() const -> Homography {
+    const auto rows = Homography::line_matrix(this->mat);
+    return Homography::from_columns(rows[0], rows[1], rows[2]);
+  }
+
+  /**
+   * @brief Inverse transformation (the adjugate)
+   *
+   * @return Homography
+   */
+  [[nodiscard]] constexpr auto inverse() const -> Homography {
+    return this->adjugate();
+  }
+
+  /**
+   * @brief Transpose
+   *
+   * @return Homography
+   */
+  [[nodiscard]] constexpr auto transpose() const -> Homography {
+    return Homography::from_columns(this->mat[0], this->mat[1], this->mat[2]);
+  }
+
+  /**
+   * @brief Map a point: M p
+   *
+   * @tparam P Point
+   * @param[in] p
+   * @return P
+   */
+  template <class P> constexpr auto map_point(const P &p) const -> P {
+    return P{Homography::apply(this->mat, p.coord)};
+  }
+
+  /**
+   * @brief Map a line: adj(M)^T l, so that map_point(p) lies on
+   *        map_line(l) whenever p lies on l
+   *
+   * @tparam L Line
+   * @param[in] l
+   * @return L
+   */
+  template <class L> constexpr auto map_line(const L &l) const -> L {
+    return L{Homography::apply(this->_line, l.coord)};
+  }
+
+  /**
+   * @brief Map a batch of points
+   *
+   * int64_t coordinates go through the SIMD transform kernel (one pass
+   * over the three columns).
+   *
+   * @tparam P Point
+   * @param[in] pts
+   * @return PgArray<P>
+   */
+  template <class P>
+  auto map_points(const PgArray<P> &pts) const -> PgArray<P> {
+    auto res = PgArray<P>(pts.size());
+    Homography::apply(this->mat, pts, res);
+    return res;
+  }
+
+  /**
+   * @brief Map a batch of points into a preallocated array (which may be
+   *        pts itself), for transforming the same buffer frame after frame
+   *
+   * @tparam P Point
+   * @param[in] pts
+   * @param[out] out of the same size as pts
+   */
+  template <class P>
+  void map_points(const PgArray<P> &pts, PgArray<P> &out) const {
+    Homography::apply(this->mat, pts, out);
+  }
+
+  /**
+   * @brief Map a batch of lines
+   *
+   * @tparam L Line
+   * @param[in] lns
+   * @return PgArray<L>
+   */
+  template <class L>
+  auto map_lines(const PgArray<L> &lns) const -> PgArray<L> {
+    auto res = PgArray<L>(lns.size());
+    Homography::apply(this->_line, lns, res);
+    return res;
+  }
+
+  /**
+   * @brief Map a batch of lines into a preallocated array (which may be
+   *        lns itself)
+   *
+   * @tparam L Line
+   * @param[in] lns
+   * @param[out] out of the same size as lns
+   */
+  template <class L>
+  void map_lines(const PgArray<L> &lns, PgArray<L> &out) const {
+    Homography::apply(this->_line, lns, out);
+  }
+
+  /**
+   * @brief Divide integer entries by their gcd (no-op for other scalars)
+   *        and refresh the cached line matrix
+   *
+   * @return Homography&
+   */
+  constexpr auto reduce() -> Homography & {
+    if constexpr (!std::is_void_v<typename binary_gcd_traits<T>::type>) {
+      auto g = T(0);
+      for (const auto &row : this->mat) {
+        for (const auto &v : row) {
+          g = gcd(g, v);
+        }
+      }
+      if (g > T(1)) {
+        for (auto &row : this->mat) {
+          for (auto &v : row) {
+            v /= g;
+          }
+        }
+      }
+    }
+    this->_line = Homography::line_matrix(this->mat);
+    return *this;
+  }
+
+  /**
+   * @brief Composition: (lhs * rhs).map_point(p) ==
+   *        lhs.map_point(rhs.map_point(p))
+   *
+   * @param[in] lhs
+   * @param[in] rhs
+   * @return Homography
+   */
+  friend constexpr auto operator*(const Homography &lhs,
+                                  const Homography &rhs) -> Homography {
+    auto res = Homography{Matrix{}};
+    for (std::size_t i = 0; i != 3; ++i) {
+      for (std::size_t j = 0; j != 3; ++j) {
+        res.mat[i][j] = lhs.mat[i][0] * rhs.mat[0][j] +
+                        lhs.mat[i][1] * rhs.mat[1][j] +
+                        lhs.mat[i][2] * rhs.mat[2][j];
+      }
+    }
+    return res.reduce();
+  }
+
+  /**
+   * @brief Equal up to a nonzero factor
+   *
+   * @param[in] lhs
+   * @param[in] rhs
+   * @return true
+   * @return false
+   */
+  friend constexpr auto operator==(const Homography &lhs,
+                                   const Homography &rhs) -> bool {
+    // compare against a nonzero pivot entry of lhs
+    std::size_t pi = 0, pj = 0;
+    while (lhs.mat[pi][pj] == T(0)) {
+      if (++pj == 3) {
+        pj = 0;
+        if (++pi == 3) {
+          return rhs.mat == lhs.mat; // lhs is zero
+        }
+      }
+    }
+    const auto &a = lhs.mat[pi][pj];
+    const auto &b = rhs.mat[pi][pj];
+    if (b == T(0)) {
+      return false;
+    }
+    for (std::size_t i = 0; i != 3; ++i) {
+      for (std::size_t j = 0; j != 3; ++j) {
+        if (lhs.mat[i][j] * b != rhs.mat[i][j] * a) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Not equal up to a nonzero factor
+   *
+   * @param[in] lhs
+   * @param[in] rhs
+   * @return true
+   * @return false
+   */
+  friend constexpr auto operator!=(const Homography &lhs,
+                                   const Homography &rhs) -> bool {
+    return !(lhs == rhs);
+  }
+
+private:
+  Matrix _line; // adj(M)^T, cached for map_line(s)
+
+  // adj(M)^T: its rows are the cross products of the rows of M
+  static constexpr auto line_matrix(const Matrix &m) -> Matrix {
+    return {::cross(m[1], m[2]), ::cross(m[2], m[0]), ::cross(m[0], m[1])};
+  }
+
+  static constexpr auto apply(const Matrix &m, const std::array<T, 3> &v)
+      -> std::array<T, 3> {
+    return {::dot(m[0], v), ::dot(m[1], v), ::dot(m[2], v)};
+  }
+
+  template <class P>
+  static void apply(const Matrix &m, const PgArray<P> &objs, PgArray<P> &out) {
+    assert(out.size() == objs.size());
+    const auto a = objs.columns();
+    const auto c = out.columns();
+    if constexpr (std::is_same_v<T, int64_t> &&
+                  std::is_same_v<typename P::value_type, int64_t>) {
+      simd::xform_batch({a[0], a[1], a[2]}, m, c, objs.size());
+    } else {
+      for (std::size_t i = 0; i != objs.size(); ++i) {
+        const auto v = Homography::apply(m, {a[0][i], a[1][i], a[2][i]});
+        c[0][i] = v[0];
+        c[1][i] = v[1];
+        c[2][i] = v[2];
+      }
+    }
+  }
+
+  // standard frame (e0, e1, e2, e0 + e1 + e2) -> pts
+  template <class P>
+  static constexpr auto frame(const std::array<P, 4> &pts) -> Homography {
+    const auto basis = Homography::from_columns(pts[0].coord, pts[1].coord,
+                                                pts[2].coord);
+    const auto ld = Homography::apply(basis.adjugate().mat, pts[3].coord);
+    auto res = basis;
+    for (auto &row : res.mat) {
+      for (std::size_t j = 0; j != 3; ++j) {
+        row[j] *= ld[j];
+      }
+    }
+    return res.reduce();
+  }
+};
+
+/**
+ * @brief Precompiled involution (harmonic homology) with the given center
+ *        and axis
+ *
+ * make_involution(origin, mirror).map_point(p) equals
+ * involution(origin, mirror, p) for every p, computed as one matrix-vector
+ * product with H = (m . o) I - 2 o m^T instead of five joins/meets, two
+ * dots and a plucker per call. The entries of H have degree 2, so the
+ * mapped coordinates also stay much smaller than those of involution().
+ *
+ * @tparam P Point
+ * @tparam L Line
+ * @param[in] origin center, not on the mirror
+ * @param[in] mirror axis
+ * @return Homography<typename P::value_type>
+ */
+template <class P, class L>
+#if __cpp_concepts >= 201907L
+  requires ProjPlanePrimDual<P, L>
+#endif
+constexpr auto make_involution(const P &origin, const L &mirror)
+    -> Homography<typename P::value_type> {
+  using T = typename P::value_type;
+  const auto &o = origin.coord;
+  const auto &m = mirror.coord;
+  const auto d = origin.dot(mirror);
+  assert(d != T(0));
+  auto res = Homography<T>{typename Homography<T>::Matrix{}};
+  for (std::size_t i = 0; i != 3; ++i) {
+    for (std::size_t j = 0; j != 3; ++j) {
+      res.mat[i][j] = (i == j ? d : T(0)) - T(2) * o[i] * m[j];
+    }
+  }
+  return res.reduce();
+}
+
+/**
+ * @brief Precompiled reflection in a mirror: the involution centered at
+ *        mirror.perp(), as in reflect()
+ *
+ * @tparam L Line
+ * @param[in] mirror
+ * @return Homography<typename L::value_type>
+ */
+template <class L, class P = typename L::Dual>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<L, P>
+#endif
+constexpr auto make_reflection(const L &mirror)
+    -> Homography<typename L::value_type> {
+  return make_involution(mirror.perp(), mirror);
+}
+
+} // namespace fun
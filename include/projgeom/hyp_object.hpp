@@ -1,69 +1,27 @@
 #pragma once
 
-#include "ck_plane.hpp"
-#include "pg_object.hpp"
-
-class HypPoint;
-class HypLine;
+#include "ck_geometry.hpp"
 
 /**
- * @brief Hyperbolic Point
+ * @brief Hyperbolic geometry: the conic x^2 + y^2 - z^2 = 0
  *
+ * perp is {x, y, -z} for both points and lines.
  */
-class HypPoint : public PgObject<HypPoint, HypLine> {
-public:
-  /**
-   * @brief Construct a new Hyp Point object
-   *
-   * @param[in] coord Homogeneous coordinate
-   */
-  constexpr explicit HypPoint(std::array<int64_t, 3> coord)
-      : PgObject<HypPoint, HypLine>{coord} {}
-
-  /**
-   * @brief
-   *
-   * @return HypLine
-   */
-  constexpr auto perp() const -> HypLine;
-};
+using HypGeometry = CKGeometry<ck_diagonal(1, 1, -1)>;
 
 /**
- * @brief Hyperbolic Line
+ * @brief Hyperbolic Point
  *
+ * @tparam T scalar
  */
-class HypLine : public PgObject<HypLine, HypPoint> {
-public:
-  /**
-   * @brief Construct a new Hyp Line object
-   *
-   * @param[in] coord Homogeneous coordinate
-   */
-  constexpr explicit HypLine(std::array<int64_t, 3> coord)
-      : PgObject<HypLine, HypPoint>{coord} {}
-
-  /**
-   * @brief
-   *
-   * @return HypPoint
-   */
-  constexpr auto perp() const -> HypPoint;
-};
+template <typename T> using BasicHypPoint = HypGeometry::Point<T>;
 
 /**
- * @brief
+ * @brief Hyperbolic Line
  *
- * @return HypLine
+ * @tparam T scalar
  */
-inline constexpr auto HypPoint::perp() const -> HypLine {
-  return HypLine({this->coord[0], this->coord[1], -this->coord[2]});
-}
+template <typename T> using BasicHypLine = HypGeometry::Line<T>;
 
-/**
- * @brief
- *
- * @return HypPoint
- */
-inline constexpr auto HypLine::perp() const -> HypPoint {
-  return HypPoint({this->coord[0], this->coord[1], -this->coord[2]});
-}
+using HypPoint = BasicHypPoint<int64_t>;
+using HypLine = BasicHypLine<int64_t>;
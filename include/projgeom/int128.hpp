@@ -0,0 +1,155 @@
+#pragma once
+
+/** @file include/projgeom/int128.hpp
+ *  128-bit products and overflow-checked int64 arithmetic. These use
+ *  __int128 and the __builtin_*_overflow intrinsics where the compiler has
+ *  them (GCC, Clang), and portable code elsewhere (e.g. MSVC).
+ */
+
+#include <cstdint>
+#include <utility>
+
+// Both can be predefined to 0 to exercise the portable code on GCC/Clang.
+#ifndef PROJGEOM_HAS_INT128
+#ifdef __SIZEOF_INT128__
+#define PROJGEOM_HAS_INT128 1
+#else
+#define PROJGEOM_HAS_INT128 0
+#endif
+#endif
+
+#ifndef PROJGEOM_HAS_OVERFLOW_BUILTINS
+#if defined(__GNUC__) || defined(__clang__)
+#define PROJGEOM_HAS_OVERFLOW_BUILTINS 1
+#else
+#define PROJGEOM_HAS_OVERFLOW_BUILTINS 0
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PROJGEOM_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define PROJGEOM_NOINLINE __declspec(noinline)
+#else
+#define PROJGEOM_NOINLINE
+#endif
+
+namespace fun {
+
+#if PROJGEOM_HAS_INT128
+/**  Widest built-in signed integer */
+using widest_int = __int128;
+#else
+/**  Widest built-in signed integer */
+using widest_int = int64_t;
+#endif
+
+namespace detail {
+
+/**
+ * @brief High and low words of the full product a * b
+ *
+ * @param[in] a
+ * @param[in] b
+ * @return std::pair<uint64_t, uint64_t> {high, low}
+ */
+constexpr auto mul_wide(uint64_t a, uint64_t b)
+    -> std::pair<uint64_t, uint64_t> {
+#if PROJGEOM_HAS_INT128
+  const auto p = static_cast<unsigned __int128>(a) * b;
+  return {static_cast<uint64_t>(p >> 64), static_cast<uint64_t>(p)};
+#else
+  constexpr auto mask = uint64_t(0xffffffff);
+  const auto a0 = a & mask, a1 = a >> 32, b0 = b & mask, b1 = b >> 32;
+  const auto p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  const auto mid = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+  return {p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32),
+          (mid << 32) | (p00 & mask)};
+#endif
+}
+
+/**
+ * @brief (hi 2^64 + lo) mod m
+ *
+ * @param[in] hi
+ * @param[in] lo
+ * @param[in] m nonzero modulus
+ * @return uint64_t
+ */
+constexpr auto mod_wide(uint64_t hi, uint64_t lo, uint64_t m) -> uint64_t {
+#if PROJGEOM_HAS_INT128
+  return static_cast<uint64_t>(
+      ((static_cast<unsigned __int128>(hi) << 64) | lo) % m);
+#else
+  // shift lo in bit by bit, keeping r < m (2 r may not fit in 64 bits)
+  auto r = hi % m;
+  for (int i = 63; i >= 0; --i) {
+    r = r >= m - r ? r - (m - r) : r + r;
+    if (((lo >> i) & 1) != 0) {
+      r = r == m - 1 ? 0 : r + 1;
+    }
+  }
+  return r;
+#endif
+}
+
+/**
+ * @brief *res = a + b, wrapping; returns whether that overflowed
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] res
+ * @return true on overflow
+ */
+constexpr auto add_overflow(int64_t a, int64_t b, int64_t *res) -> bool {
+#if PROJGEOM_HAS_OVERFLOW_BUILTINS
+  return __builtin_add_overflow(a, b, res);
+#else
+  *res = static_cast<int64_t>(static_cast<uint64_t>(a) +
+                              static_cast<uint64_t>(b));
+  return (a < 0) == (b < 0) && (*res < 0) != (a < 0);
+#endif
+}
+
+/**
+ * @brief *res = a - b, wrapping; returns whether that overflowed
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] res
+ * @return true on overflow
+ */
+constexpr auto sub_overflow(int64_t a, int64_t b, int64_t *res) -> bool {
+#if PROJGEOM_HAS_OVERFLOW_BUILTINS
+  return __builtin_sub_overflow(a, b, res);
+#else
+  *res = static_cast<int64_t>(static_cast<uint64_t>(a) -
+                              static_cast<uint64_t>(b));
+  return (a < 0) != (b < 0) && (*res < 0) != (a < 0);
+#endif
+}
+
+/**
+ * @brief *res = a * b, wrapping; returns whether that overflowed
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] res
+ * @return true on overflow
+ */
+constexpr auto mul_overflow(int64_t a, int64_t b, int64_t *res) -> bool {
+#if PROJGEOM_HAS_OVERFLOW_BUILTINS
+  return __builtin_mul_overflow(a, b, res);
+#else
+  const bool neg = (a < 0) != (b < 0);
+  const auto ua = a < 0 ? uint64_t(0) - uint64_t(a) : uint64_t(a);
+  const auto ub = b < 0 ? uint64_t(0) - uint64_t(b) : uint64_t(b);
+  const auto [hi, lo] = mul_wide(ua, ub);
+  *res = static_cast<int64_t>(neg ? uint64_t(0) - lo : lo);
+  return hi != 0 || lo > (neg ? uint64_t(1) << 63 : uint64_t(INT64_MAX));
+#endif
+}
+
+} // namespace detail
+
+} // namespace fun
@@ -0,0 +1,315 @@
+// -*- coding: utf-16 -*-
+#pragma once
+
+/** @file include/projgeom/lazy_fraction.hpp
+ *  Fraction that defers gcd reduction.
+ */
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "fractions.hpp"
+
+namespace fun {
+
+/**
+ * @brief Double-width integer for exact cross-multiplication
+ *
+ * @tparam Z
+ */
+template <typename Z> struct wider {
+  using type = Z;
+};
+template <> struct wider<int32_t> {
+  using type = int64_t;
+};
+#ifdef __SIZEOF_INT128__
+template <> struct wider<int64_t> {
+  using type = __int128;
+};
+#endif
+
+/**
+ * @brief Fraction with lazy normalization
+ *
+ * Unlike Fraction, arithmetic does not reduce by the gcd after every
+ * operation. The denominator is kept positive. A reduction is attempted
+ * only when the numerator or denominator grows past Bits bits, or when
+ * canonical()/reduce() is called. An irreducible value wider than Bits
+ * stays wide, so the next product can still overflow Z, as with Fraction.
+ * Comparisons cross-multiply in a double-width integer instead of reducing
+ * both sides.
+ *
+ * @tparam Z int32_t or int64_t
+ * @tparam Bits reduction threshold in bits
+ */
+template <typename Z, int Bits = std::numeric_limits<Z>::digits / 2 - 1>
+struct LazyFraction {
+  using W = typename wider<Z>::type;
+  using U = typename binary_gcd_traits<Z>::type;
+
+  Z _num;
+  Z _den;
+
+  /**
+   * @brief Construct a new Lazy Fraction object
+   *
+   * @param[in] num
+   * @param[in] den
+   */
+  constexpr LazyFraction(Z num, Z den) : _num{num}, _den{den} {
+    if (this->_den < Z(0)) {
+      this->_num = -this->_num;
+      this->_den = -this->_den;
+    }
+    this->reduce_if_wide();
+  }
+
+  /**
+   * @brief Construct a new Lazy Fraction object
+   *
+   * @param[in] num
+   */
+  constexpr explicit LazyFraction(Z num) : _num{num}, _den{Z(1)} {}
+
+  /**
+   * @brief Construct a new Lazy Fraction object
+   *
+   */
+  constexpr LazyFraction() : _num{Z(0)}, _den{Z(1)} {}
+
+  /**
+   * @brief Construct a new Lazy Fraction object
+   *
+   * @param[in] frac
+   */
+  constexpr explicit LazyFraction(const Fraction<Z> &frac)
+      : _num{frac.num()}, _den{frac.den()} {}
+
+  /**
+   * @brief Numerator (not necessarily reduced)
+   *
+   * @return const Z&
+   */
+  [[nodiscard]] constexpr auto num() const noexcept -> const Z & {
+    return _num;
+  }
+
+  /**
+   * @brief Denominator (positive, not necessarily reduced)
+   *
+   * @return const Z&
+   */
+  [[nodiscard]] constexpr auto den() const noexcept -> const Z & {
+    return _den;
+  }
+
+  /**
+   * @brief Reduce by the gcd
+   *
+   * @return Z the common factor removed
+   */
+  constexpr auto reduce() -> Z {
+    const auto common = gcd(this->_num, this->_den);
+    if (common != Z(1) && common != Z(0)) {
+      this->_num /= common;
+      this->_den /= common;
+    }
+    return common;
+  }
+
+  /**
+   * @brief Canonical value
+   *
+   * @return Fraction<Z>
+   */
+  [[nodiscard]] constexpr auto canonical() const -> Fraction<Z> {
+    return Fraction<Z>(this->_num, this->_den);
+  }
+
+  /**
+   * @brief Whether numerator or denominator exceeds the threshold
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] constexpr auto is_wide() const noexcept -> bool {
+    const auto n = this->_num < Z(0) ? U(0) - U(this->_num) : U(this->_num);
+    return std::bit_width(n | U(this->_den)) > Bits;
+  }
+
+  /**
+   * @brief Reduce only if the threshold has been crossed
+   *
+   */
+  constexpr void reduce_if_wide() {
+    if (this->is_wide()) {
+      this->reduce();
+    }
+  }
+
+  /** @name Comparison operators
+   *  ==, !=, <, >, <=, >= etc.
+   */
+  ///@{
+
+  friend constexpr auto operator==(const LazyFraction &lhs,
+                                   const LazyFraction &rhs) -> bool {
+    return W(lhs._num) * W(rhs._den) == W(rhs._num) * W(lhs._den);
+  }
+
+  friend constexpr auto operator!=(const LazyFraction &lhs,
+                                   const LazyFraction &rhs) -> bool {
+    return !(lhs == rhs);
+  }
+
+  friend constexpr auto operator<(const LazyFraction &lhs,
+                                  const LazyFraction &rhs) -> bool {
+    return W(lhs._num) * W(rhs._den) < W(rhs._num) * W(lhs._den);
+  }
+
+  friend constexpr auto operator>(const LazyFraction &lhs,
+                                  const LazyFraction &rhs) -> bool {
+    return rhs < lhs;
+  }
+
+  friend constexpr auto operator<=(const LazyFraction &lhs,
+                                   const LazyFraction &rhs) -> bool {
+    return !(rhs < lhs);
+  }
+
+  friend constexpr auto operator>=(const LazyFraction &lhs,
+                                   const LazyFraction &rhs) -> bool {
+    return !(lhs < rhs);
+  }
+
+  friend constexpr auto operator==(const LazyFraction &lhs, const Z &rhs)
+      -> bool {
+    return W(lhs._num) == W(rhs) * W(lhs._den);
+  }
+
+  friend constexpr auto operator<(const LazyFraction &lhs, const Z &rhs)
+      -> bool {
+    return W(lhs._num) < W(rhs) * W(lhs._den);
+  }
+
+  friend constexpr auto operator<(const Z &lhs, const LazyFraction &rhs)
+      -> bool {
+    return W(lhs) * W(rhs._den) < W(rhs._num);
+  }
+
+  ///@}
+
+  /**
+   * @brief Negate
+   *
+   * @return LazyFraction
+   */
+  constexpr auto operator-() const -> LazyFraction {
+    auto res = *this;
+    res._num = -res._num;
+    return res;
+  }
+
+  constexpr auto operator+=(const LazyFraction &rhs) -> LazyFraction & {
+    if (this->_den == rhs._den) {
+      this->_num += rhs._num;
+    } else {
+      this->_num = this->_num * rhs._den + rhs._num * this->_den;
+      this->_den *= rhs._den;
+    }
+    this->reduce_if_wide();
+    return *this;
+  }
+
+  constexpr auto operator-=(const LazyFraction &rhs) -> LazyFraction & {
+    return *this += -rhs;
+  }
+
+  constexpr auto operator*=(const LazyFraction &rhs) -> LazyFraction & {
+    this->_num *= rhs._num;
+    this->_den *= rhs._den;
+    this->reduce_if_wide();
+    return *this;
+  }
+
+  constexpr auto operator/=(const LazyFraction &rhs) -> LazyFraction & {
+    this->_num *= rhs._den;
+    this->_den *= rhs._num;
+    if (this->_den < Z(0)) {
+      this->_num = -this->_num;
+      this->_den = -this->_den;
+    }
+    this->reduce_if_wide();
+    return *this;
+  }
+
+  constexpr auto operator+=(const Z &rhs) -> LazyFraction & {
+    this->_num += rhs * this->_den;
+    this->reduce_if_wide();
+    return *this;
+  }
+
+  constexpr auto operator-=(const Z &rhs) -> LazyFraction & {
+    return *this += -rhs;
+  }
+
+  constexpr auto operator*=(const Z &rhs) -> LazyFraction & {
+    this->_num *= rhs;
+    this->reduce_if_wide();
+    return *this;
+  }
+
+  friend constexpr auto operator+(LazyFraction lhs, const LazyFraction &rhs)
+      -> LazyFraction {
+    return lhs += rhs;
+  }
+
+  friend constexpr auto operator-(LazyFraction lhs, const LazyFraction &rhs)
+      -> LazyFraction {
+    return lhs -= rhs;
+  }
+
+  friend constexpr auto operator*(LazyFraction lhs, const LazyFraction &rhs)
+      -> LazyFraction {
+    return lhs *= rhs;
+  }
+
+  friend constexpr auto operator/(LazyFraction lhs, const LazyFraction &rhs)
+      -> LazyFraction {
+    return lhs /= rhs;
+  }
+
+  friend constexpr auto operator+(LazyFraction lhs, const Z &rhs)
+      -> LazyFraction {
+    return lhs += rhs;
+  }
+
+  friend constexpr auto operator-(LazyFraction lhs, const Z &rhs)
+      -> LazyFraction {
+    return lhs -= rhs;
+  }
+
+  friend constexpr auto operator*(LazyFraction lhs, const Z &rhs)
+      -> LazyFraction {
+    return lhs *= rhs;
+  }
+
+  /**
+   * @brief
+   *
+   * @tparam _Stream
+   * @param[in] os
+   * @param[in] frac
+   * @return _Stream&
+   */
+  template <typename _Stream>
+  friend auto operator<<(_Stream &os, const LazyFraction &frac) -> _Stream & {
+    os << "(" << frac.num() << "/" << frac.den() << ")";
+    return os;
+  }
+};
+
+} // namespace fun
@@ -0,0 +1,271 @@
+#pragma once
+
+/** @file include/projgeom/modint.hpp
+ *  Prime-field scalar GF(p) with Montgomery multiplication.
+ */
+
+#include <cassert>
+#include <cstdint>
+
+#include "int128.hpp"
+
+namespace fun {
+
+/**
+ * @brief Montgomery arithmetic modulo an odd 64-bit modulus (R = 2^64)
+ *
+ * Values are kept in Montgomery form x R mod m, in [0, m). The modulus
+ * must be odd and below 2^63, so that t + q m in reduce() cannot overflow
+ * 128 bits. Usable both at compile time (ModInt) and with a modulus chosen
+ * at run time.
+ */
+struct Montgomery {
+  uint64_t mod;  //!< odd modulus m < 2^63
+  uint64_t ninv; //!< -m^{-1} mod 2^64
+  uint64_t r2;   //!< R^2 mod m
+
+  /**
+   * @brief Construct a new Montgomery object
+   *
+   * @param[in] m odd modulus below 2^63
+   */
+  constexpr explicit Montgomery(uint64_t m) : mod{m}, ninv{0}, r2{0} {
+    assert(m % 2 == 1 && m < (uint64_t(1) << 63));
+    auto inv = m; // correct to 3 bits; each Newton step doubles that
+    for (int i = 0; i != 5; ++i) {
+      inv *= 2 - m * inv;
+    }
+    this->ninv = uint64_t(0) - inv;
+    const auto r1 = (uint64_t(0) - m) % m; // R mod m
+    const auto [hi, lo] = detail::mul_wide(r1, r1);
+    this->r2 = detail::mod_wide(hi, lo, m);
+  }
+
+  /**
+   * @brief Montgomery reduction: t R^{-1} mod m, for t = hi R + lo < m R
+   *
+   * @param[in] hi
+   * @param[in] lo
+   * @return uint64_t
+   */
+  [[nodiscard]] constexpr auto reduce(uint64_t hi, uint64_t lo) const noexcept
+      -> uint64_t {
+    const auto q = lo * this->ninv;
+    const auto [qhi, qlo] = detail::mul_wide(q, this->mod);
+    // lo + qlo is 0 mod R, so it carries exactly when lo != 0
+    const auto u = hi + qhi + (lo != 0 ? 1 : 0);
+    return u >= this->mod ? u - this->mod : u;
+  }
+
+  [[nodiscard]] constexpr auto to_mont(uint64_t x) const noexcept
+      -> uint64_t {
+    return this->mul(x % this->mod, this->r2);
+  }
+
+  [[nodiscard]] constexpr auto from_mont(uint64_t x) const noexcept
+      -> uint64_t {
+    return this->reduce(0, x);
+  }
+
+  [[nodiscard]] constexpr auto mul(uint64_t a, uint64_t b) const noexcept
+      -> uint64_t {
+    const auto [hi, lo] = detail::mul_wide(a, b);
+    return this->reduce(hi, lo);
+  }
+
+  [[nodiscard]] constexpr auto add(uint64_t a, uint64_t b) const noexcept
+      -> uint64_t {
+    const auto s = a + b; // < 2^64 since both are below 2^63
+    return s >= this->mod ? s - this->mod : s;
+  }
+
+  [[nodiscard]] constexpr auto sub(uint64_t a, uint64_t b) const noexcept
+      -> uint64_t {
+    return a >= b ? a - b : a + this->mod - b;
+  }
+
+  /**
+   * @brief Montgomery form of a signed integer
+   *
+   * @param[in] x
+   * @return uint64_t
+   */
+  [[nodiscard]] constexpr auto from_signed(int64_t x) const noexcept
+      -> uint64_t {
+    const auto r = x < 0 ? this->mod - (uint64_t(0) - uint64_t(x)) % this->mod
+                         : uint64_t(x);
+    return this->to_mont(r); // to_mont reduces r == mod to 0
+  }
+
+  /**
+   * @brief a^e in Montgomery form
+   *
+   * @param[in] a Montgomery form
+   * @param[in] e exponent
+   * @return uint64_t
+   */
+  [[nodiscard]] constexpr auto pow(uint64_t a, uint64_t e) const noexcept
+      -> uint64_t {
+    auto res = this->to_mont(1);
+    for (; e != 0; e >>= 1) {
+      if (e & 1) {
+        res = this->mul(res, a);
+      }
+      a = this->mul(a, a);
+    }
+    return res;
+  }
+};
+
+/**
+ * @brief Element of the prime field GF(p)
+ *
+ * Fixed-width scalar for PgObject and the CK geometries: coordinates never
+ * grow, so finite planes can be enumerated exhaustively. Satisfies the
+ * Integral concept of common_concepts.h: since GF(p) is a field, `/` is
+ * exact division and `%` is always zero. The order used by `<` is that of
+ * the residues in [0, p); it exists only to satisfy the concept.
+ *
+ * @tparam p odd prime below 2^63
+ */
+template <uint64_t p> class ModInt {
+  static constexpr Montgomery mont{p};
+
+  uint64_t _v{0}; // Montgomery form
+
+  struct raw_tag {};
+  constexpr ModInt(uint64_t v, raw_tag) : _v{v} {}
+
+public:
+  static constexpr uint64_t modulus = p;
+
+  /**
+   * @brief Construct a zero ModInt
+   *
+   */
+  constexpr ModInt() = default;
+
+  /**
+   * @brief Construct a new ModInt object
+   *
+   * @param[in] x
+   */
+  constexpr ModInt(int64_t x) : _v{mont.from_signed(x)} {}
+
+  /**
+   * @brief Construct a new ModInt object
+   *
+   * @param[in] x
+   */
+  constexpr ModInt(int x) : _v{mont.from_signed(x)} {}
+
+  /**
+   * @brief Canonical residue in [0, p)
+   *
+   * @return uint64_t
+   */
+  [[nodiscard]] constexpr auto value() const noexcept -> uint64_t {
+    return mont.from_mont(this->_v);
+  }
+
+  /**
+   * @brief Multiplicative inverse (Fermat)
+   *
+   * @return ModInt
+   */
+  [[nodiscard]] constexpr auto inverse() const noexcept -> ModInt {
+    assert(this->_v != 0);
+    return ModInt(mont.pow(this->_v, p - 2), raw_tag{});
+  }
+
+  constexpr auto operator+=(const ModInt &rhs) noexcept -> ModInt & {
+    this->_v = mont.add(this->_v, rhs._v);
+    return *this;
+  }
+
+  constexpr auto operator-=(const ModInt &rhs) noexcept -> ModInt & {
+    this->_v = mont.sub(this->_v, rhs._v);
+    return *this;
+  }
+
+  constexpr auto operator*=(const ModInt &rhs) noexcept -> ModInt & {
+    this->_v = mont.mul(this->_v, rhs._v);
+    return *this;
+  }
+
+  constexpr auto operator/=(const ModInt &rhs) noexcept -> ModInt & {
+    return *this *= rhs.inverse();
+  }
+
+  constexpr auto operator%=(const ModInt & /* rhs */) noexcept -> ModInt & {
+    this->_v = 0;
+    return *this;
+  }
+
+  constexpr auto operator-() const noexcept -> ModInt {
+    return ModInt(mont.sub(0, this->_v), raw_tag{});
+  }
+
+  friend constexpr auto operator+(ModInt lhs, const ModInt &rhs) noexcept
+      -> ModInt {
+    return lhs += rhs;
+  }
+
+  friend constexpr auto operator-(ModInt lhs, const ModInt &rhs) noexcept
+      -> ModInt {
+    return lhs -= rhs;
+  }
+
+  friend constexpr auto operator*(ModInt lhs, const ModInt &rhs) noexcept
+      -> ModInt {
+    return lhs *= rhs;
+  }
+
+  friend constexpr auto operator/(ModInt lhs, const ModInt &rhs) noexcept
+      -> ModInt {
+    return lhs /= rhs;
+  }
+
+  friend constexpr auto operator%(ModInt lhs, const ModInt &rhs) noexcept
+      -> ModInt {
+    return lhs %= rhs;
+  }
+
+  friend constexpr auto operator==(const ModInt &lhs, const ModInt &rhs)
+      -> bool {
+    return lhs._v == rhs._v;
+  }
+
+  friend constexpr auto operator!=(const ModInt &lhs, const ModInt &rhs)
+      -> bool {
+    return lhs._v != rhs._v;
+  }
+
+  friend constexpr auto operator<(const ModInt &lhs, const ModInt &rhs)
+      -> bool {
+    return lhs.value() < rhs.value();
+  }
+
+  friend constexpr auto operator>(const ModInt &lhs, const ModInt &rhs)
+      -> bool {
+    return rhs < lhs;
+  }
+
+  friend constexpr auto operator<=(const ModInt &lhs, const ModInt &rhs)
+      -> bool {
+    return !(rhs < lhs);
+  }
+
+  friend constexpr auto operator>=(const ModInt &lhs, const ModInt &rhs)
+      -> bool {
+    return !(lhs < rhs);
+  }
+
+  template <typename _Stream>
+  friend auto operator<<(_Stream &os, const ModInt &a) -> _Stream & {
+    os << a.value();
+    return os;
+  }
+};
+
+} // namespace fun
@@ -0,0 +1,515 @@
+#pragma once
+
+/** @file include/projgeom/modular_verify.hpp
+ *  Residue-number-system scalar for probabilistic verification of
+ *  geometric identities at fixed width.
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+#include "bigint.hpp"
+#include "modint.hpp"
+
+namespace fun {
+
+/**
+ * @brief Deterministic Miller-Rabin primality test for 64-bit integers
+ *
+ * @param[in] n
+ * @return true
+ * @return false
+ */
+inline auto is_prime_u64(uint64_t n) -> bool {
+  if (n < 2) {
+    return false;
+  }
+  for (const uint64_t q : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+    if (n % q == 0) {
+      return n == q;
+    }
+  }
+  if (n >= (uint64_t(1) << 63)) {
+    return false; // not needed here; Montgomery requires n < 2^63
+  }
+  auto d = n - 1;
+  int s = 0;
+  while (d % 2 == 0) {
+    d /= 2;
+    ++s;
+  }
+  const auto mont = Montgomery{n};
+  const auto one = mont.to_mont(1);
+  const auto minus_one = mont.to_mont(n - 1);
+  // these bases are a deterministic witness set for all n < 2^64
+  for (const uint64_t a : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+    auto x = mont.pow(mont.to_mont(a), d);
+    if (x == one || x == minus_one) {
+      continue;
+    }
+    auto composite = true;
+    for (int r = 1; r < s && composite; ++r) {
+      x = mont.mul(x, x);
+      composite = x != minus_one;
+    }
+    if (composite) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief A 64-bit seed from std::random_device
+ *
+ * @return uint64_t
+ */
+inline auto random_seed() -> uint64_t {
+  std::random_device rd;
+  return (uint64_t(rd()) << 32) ^ rd();
+}
+
+/**
+ * @brief K distinct random primes in [2^60, 2^61)
+ *
+ * Candidates are drawn uniformly and rejected unless prime, so each prime
+ * is uniform over the about 2^54.6 primes of the interval. A basis is
+ * immutable once built and can be shared between threads; a fresh seed
+ * means a new basis object, which leaves the values of the old one
+ * intact.
+ *
+ * @tparam K
+ */
+template <std::size_t K> class RnsBasis {
+  std::array<Montgomery, K> _lanes;
+
+public:
+  /**
+   * @brief Construct a new Rns Basis object
+   *
+   * @param[in] seed
+   */
+  explicit RnsBasis(uint64_t seed) : _lanes{make(seed)} {}
+
+  RnsBasis(const RnsBasis &) = delete;
+  auto operator=(const RnsBasis &) -> RnsBasis & = delete;
+
+  /**
+   * @brief Montgomery arithmetic of lane i
+   *
+   * @param[in] i
+   * @return const Montgomery&
+   */
+  [[nodiscard]] auto lane(std::size_t i) const noexcept -> const Montgomery & {
+    return this->_lanes[i];
+  }
+
+  /**
+   * @brief Prime of lane i
+   *
+   * @param[in] i
+   * @return uint64_t
+   */
+  [[nodiscard]] auto prime(std::size_t i) const noexcept -> uint64_t {
+    return this->_lanes[i].mod;
+  }
+
+private:
+  static auto make(uint64_t seed) -> std::array<Montgomery, K> {
+    std::mt19937_64 gen{seed};
+    std::uniform_int_distribution<uint64_t> dist{uint64_t(1) << 60,
+                                                 (uint64_t(1) << 61) - 1};
+    std::array<uint64_t, K> primes{};
+    for (std::size_t i = 0; i != K;) {
+      const auto cand = dist(gen) | 1U;
+      auto fresh = is_prime_u64(cand);
+      for (std::size_t j = 0; j != i && fresh; ++j) {
+        fresh = primes[j] != cand;
+      }
+      if (fresh) {
+        primes[i++] = cand;
+      }
+    }
+    return make_lanes(primes, std::make_index_sequence<K>{});
+  }
+
+  template <std::size_t... I>
+  static auto make_lanes(const std::array<uint64_t, K> &primes,
+                         std::index_sequence<I...>)
+      -> std::array<Montgomery, K> {
+    return {Montgomery{primes[I]}...};
+  }
+};
+
+/**
+ * @brief Upper bound on the probability that K random primes of
+ *        [2^60, 2^61) all divide a nonzero integer of `bits` bits
+ *
+ * Such an integer has fewer than bits/60 prime factors in the interval,
+ * which holds more than 2^54 primes.
+ *
+ * @param[in] num_primes K
+ * @param[in] bits
+ * @return double
+ */
+inline auto rns_error_bound(std::size_t num_primes, std::size_t bits)
+    -> double {
+  const auto per_lane = std::ceil(double(bits) / 60.0) / std::ldexp(1.0, 54);
+  return std::min(1.0, std::pow(per_lane, double(num_primes)));
+}
+
+/**
+ * @brief Makes a basis current on this thread while the scope lives
+ *
+ * RnsInt<K> values built from plain integers (including the T(0), T(1)
+ * of generic code) take the innermost scope's basis. Every equality test
+ * that finds equal residues adds its error probability to the scope; an
+ * inner scope passes its total on to the outer one when it ends.
+ *
+ * @tparam K
+ */
+template <std::size_t K> class RnsScope {
+  const RnsBasis<K> &_basis;
+  RnsScope *_outer;
+  double _error{};
+
+  static inline thread_local RnsScope *innermost = nullptr;
+
+public:
+  /**
+   * @brief Construct a new Rns Scope object
+   *
+   * @param[in] basis must outlive every value built in the scope
+   */
+  explicit RnsScope(const RnsBasis<K> &basis)
+      : _basis{basis}, _outer{innermost} {
+    innermost = this;
+  }
+
+  ~RnsScope() {
+    innermost = this->_outer;
+    if (this->_outer != nullptr) {
+      this->_outer->record(this->_error);
+    }
+  }
+
+  RnsScope(const RnsScope &) = delete;
+  auto operator=(const RnsScope &) -> RnsScope & = delete;
+
+  /**
+   * @brief The innermost scope of this thread (nullptr if none)
+   *
+   * @return RnsScope*
+   */
+  static auto current() noexcept -> RnsScope * { return innermost; }
+
+  /**
+   * @brief The basis of this scope
+   *
+   * @return const RnsBasis<K>&
+   */
+  [[nodiscard]] auto basis() const noexcept -> const RnsBasis<K> & {
+    return this->_basis;
+  }
+
+  /**
+   * @brief Union bound on the probability that some equality test of
+   *        this scope wrongly found equal residues
+   *
+   * @return double
+   */
+  [[nodiscard]] auto error_bound() const noexcept -> double {
+    return this->_error;
+  }
+
+  /**
+   * @brief Add the error probability of one test
+   *
+   * @param[in] error
+   */
+  void record(double error) noexcept {
+    this->_error = std::min(1.0, this->_error + error);
+  }
+};
+
+/**
+ * @brief Integer represented by its residues modulo K random 61-bit primes
+ *
+ * A ring scalar for PgObject and the CK geometries: every operation is K
+ * independent Montgomery lane operations, so the cost per operation is
+ * fixed no matter how large the true value is. Each value keeps a pointer
+ * to its basis (the default zero has none and works with any) and a bound
+ * 2^bits() on its magnitude, carried through + - *. Equality is exact in
+ * one direction only: different residues prove the values differ, while
+ * equal residues mean equal values except with probability at most
+ * rns_error_bound(K, bits) of the difference, which is recorded in the
+ * current RnsScope. to_big() reconstructs the exact value by CRT when it
+ * is below M/2, M being the product of the primes.
+ *
+ * @tparam K number of primes (lanes)
+ */
+template <std::size_t K> class RnsInt {
+  const RnsBasis<K> *_basis{};
+  std::array<uint64_t, K> _r{}; // Montgomery form per lane
+  std::size_t _bits{};          // |value| < 2^_bits
+
+  static auto current_basis() -> const RnsBasis<K> & {
+    const auto *scope = RnsScope<K>::current();
+    assert(scope != nullptr && "RnsInt from an integer needs an RnsScope");
+    return scope->basis();
+  }
+
+  // the common basis of two operands (either may be the basisless zero)
+  static auto common(const RnsInt &lhs, const RnsInt &rhs)
+      -> const RnsBasis<K> * {
+    assert(lhs._basis == nullptr || rhs._basis == nullptr ||
+           lhs._basis == rhs._basis);
+    return lhs._basis != nullptr ? lhs._basis : rhs._basis;
+  }
+
+public:
+  /**
+   * @brief Construct a zero RnsInt (valid in every basis)
+   *
+   */
+  RnsInt() = default;
+
+  /**
+   * @brief Construct a new RnsInt object
+   *
+   * @param[in] basis
+   * @param[in] x
+   */
+  RnsInt(const RnsBasis<K> &basis, int64_t x) : _basis{&basis} {
+    for (std::size_t i = 0; i != K; ++i) {
+      this->_r[i] = basis.lane(i).from_signed(x);
+    }
+    this->_bits = std::size_t(
+        std::bit_width(x < 0 ? uint64_t(0) - uint64_t(x) : uint64_t(x)));
+  }
+
+  /**
+   * @brief Construct a new RnsInt object
+   *
+   * @param[in] basis
+   * @param[in] x
+   */
+  RnsInt(const RnsBasis<K> &basis, const BigInt &x)
+      : _basis{&basis}, _bits{x.bit_width()} {
+    for (std::size_t i = 0; i != K; ++i) {
+      this->_r[i] = basis.lane(i).to_mont(x.mod(basis.prime(i)));
+    }
+  }
+
+  /**
+   * @brief Construct a new RnsInt object in the current scope's basis
+   *
+   * @param[in] x
+   */
+  RnsInt(int64_t x) : RnsInt(current_basis(), x) {}
+
+  /**
+   * @brief Construct a new RnsInt object in the current scope's basis
+   *
+   * @param[in] x
+   */
+  RnsInt(int x) : RnsInt(int64_t(x)) {}
+
+  /**
+   * @brief Construct a new RnsInt object in the current scope's basis
+   *
+   * @param[in] x
+   */
+  explicit RnsInt(const BigInt &x) : RnsInt(current_basis(), x) {}
+
+  /**
+   * @brief The basis of this value (nullptr for the default zero)
+   *
+   * @return const RnsBasis<K>*
+   */
+  [[nodiscard]] auto basis() const noexcept -> const RnsBasis<K> * {
+    return this->_basis;
+  }
+
+  /**
+   * @brief Bound on the magnitude: |value| < 2^bits()
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto bits() const noexcept -> std::size_t {
+    return this->_bits;
+  }
+
+  /**
+   * @brief Residue in lane i, in [0, prime(i))
+   *
+   * @param[in] i
+   * @return uint64_t
+   */
+  [[nodiscard]] auto residue(std::size_t i) const -> uint64_t {
+    return this->_basis == nullptr
+               ? 0
+               : this->_basis->lane(i).from_mont(this->_r[i]);
+  }
+
+  /**
+   * @brief Whether every residue is zero
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto is_zero() const -> bool {
+    for (const auto r : this->_r) {
+      if (r != 0) {
+        return false;
+      }
+    }
+    if (auto *scope = RnsScope<K>::current(); scope != nullptr) {
+      scope->record(rns_error_bound(K, this->_bits));
+    }
+    return true;
+  }
+
+  /**
+   * @brief Exact value by CRT (Garner), valid when |value| < M/2
+   *
+   * @return BigInt
+   */
+  [[nodiscard]] auto to_big() const -> BigInt {
+    if (this->_basis == nullptr) {
+      return BigInt{};
+    }
+    const auto &b = *this->_basis;
+    // mixed-radix digits: value = d0 + d1 m0 + d2 m0 m1 + ...
+    std::array<uint64_t, K> digit{};
+    for (std::size_t i = 0; i != K; ++i) {
+      const auto &mi = b.lane(i);
+      auto x = mi.to_mont(this->residue(i));
+      for (std::size_t j = 0; j != i; ++j) {
+        const auto mj_inv = mi.pow(mi.to_mont(b.prime(j)), mi.mod - 2);
+        x = mi.mul(mi.sub(x, mi.to_mont(digit[j])), mj_inv);
+      }
+      digit[i] = mi.from_mont(x);
+    }
+    auto value = BigInt{};
+    auto radix = BigInt{1};
+    for (std::size_t i = 0; i != K; ++i) {
+      value += BigInt{int64_t(digit[i])} * radix;
+      radix *= BigInt{int64_t(b.prime(i))};
+    }
+    if (value + value > radix) {
+      value -= radix;
+    }
+    return value;
+  }
+
+  auto operator+=(const RnsInt &rhs) -> RnsInt & {
+    this->_basis = common(*this, rhs);
+    if (this->_basis != nullptr) {
+      for (std::size_t i = 0; i != K; ++i) {
+        this->_r[i] = this->_basis->lane(i).add(this->_r[i], rhs._r[i]);
+      }
+    }
+    this->_bits = std::max(this->_bits, rhs._bits) + 1;
+    return *this;
+  }
+
+  auto operator-=(const RnsInt &rhs) -> RnsInt & {
+    this->_basis = common(*this, rhs);
+    if (this->_basis != nullptr) {
+      for (std::size_t i = 0; i != K; ++i) {
+        this->_r[i] = this->_basis->lane(i).sub(this->_r[i], rhs._r[i]);
+      }
+    }
+    this->_bits = std::max(this->_bits, rhs._bits) + 1;
+    return *this;
+  }
+
+  auto operator*=(const RnsInt &rhs) -> RnsInt & {
+    this->_basis = common(*this, rhs);
+    if (this->_basis != nullptr) {
+      for (std::size_t i = 0; i != K; ++i) {
+        this->_r[i] = this->_basis->lane(i).mul(this->_r[i], rhs._r[i]);
+      }
+    }
+    this->_bits += rhs._bits;
+    return *this;
+  }
+
+  auto operator-() const -> RnsInt {
+    auto res = RnsInt{} -= *this;
+    res._bits = this->_bits;
+    return res;
+  }
+
+  friend auto operator+(RnsInt lhs, const RnsInt &rhs) -> RnsInt {
+    return lhs += rhs;
+  }
+
+  friend auto operator-(RnsInt lhs, const RnsInt &rhs) -> RnsInt {
+    return lhs -= rhs;
+  }
+
+  friend auto operator*(RnsInt lhs, const RnsInt &rhs) -> RnsInt {
+    return lhs *= rhs;
+  }
+
+  friend auto operator==(const RnsInt &lhs, const RnsInt &rhs) -> bool {
+    return (lhs - rhs).is_zero();
+  }
+
+  friend auto operator!=(const RnsInt &lhs, const RnsInt &rhs) -> bool {
+    return !(lhs == rhs);
+  }
+
+  template <typename _Stream>
+  friend auto operator<<(_Stream &os, const RnsInt &a) -> _Stream & {
+    os << a.to_big();
+    return os;
+  }
+};
+
+/**
+ * @brief Verdict of a modular identity check
+ */
+struct ModularVerdict {
+  bool holds;         //!< all lanes agree that the identity holds
+  double error_bound; //!< probability that `holds` is wrong
+};
+
+/**
+ * @brief Evaluate an identity check over RnsInt<K>
+ *
+ * `check` runs a construction from pg_plane.hpp/ck_plane.hpp on RnsInt<K>
+ * coordinates in `basis` and returns its bool; it is run inside an
+ * RnsScope of `basis`, so it can also build its inputs from plain
+ * integers. The error bound is not supplied by the caller: it is the sum,
+ * over every equality test made by check, of rns_error_bound() for the
+ * bit-size bound the RnsInt operands carry. A test that finds different
+ * residues is certain and adds nothing, so a check that takes no
+ * equal-residue branch is exact either way.
+ *
+ * The bound assumes that the inputs were chosen independently of the
+ * basis (e.g. a basis from random_seed(), or a caller's own seed).
+ *
+ * @tparam K
+ * @tparam F callable returning bool
+ * @param[in] basis
+ * @param[in] check
+ * @return ModularVerdict
+ */
+template <std::size_t K, typename F>
+auto modular_check(const RnsBasis<K> &basis, F &&check) -> ModularVerdict {
+  auto scope = RnsScope<K>{basis};
+  const bool holds = check();
+  return {holds, scope.error_bound()};
+}
+
+} // namespace fun
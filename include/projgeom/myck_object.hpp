@@ -1,69 +1,27 @@
 #pragma once
 
-#include "ck_plane.hpp"
-#include "pg_object.hpp"
-
-class MyCKPoint;
-class MyCKLine;
+#include "ck_geometry.hpp"
 
 /**
- * @brief Some C-K Point
+ * @brief Some C-K geometry: the conic -2x^2 + y^2 - 2z^2 = 0
  *
+ * perp is {-2x, y, -2z} for points and {-x, 2y, -z} for lines.
  */
-class MyCKPoint : public PgObject<MyCKPoint, MyCKLine> {
-public:
-  /**
-   * @brief Construct a new My C K Point object
-   *
-   * @param[in] coord Homogeneous coordinate
-   */
-  constexpr explicit MyCKPoint(std::array<int64_t, 3> coord)
-      : PgObject<MyCKPoint, MyCKLine>{coord} {}
-
-  /**
-   * @brief
-   *
-   * @return MyCKLine
-   */
-  constexpr auto perp() const -> MyCKLine;
-};
+using MyCKGeometry = CKGeometry<ck_diagonal(-2, 1, -2)>;
 
 /**
- * @brief Some C-K Line
+ * @brief Some C-K Point
  *
+ * @tparam T scalar
  */
-class MyCKLine : public PgObject<MyCKLine, MyCKPoint> {
-public:
-  /**
-   * @brief Construct a new My C K Line object
-   *
-   * @param[in] coord Homogeneous coordinate
-   */
-  constexpr explicit MyCKLine(std::array<int64_t, 3> coord)
-      : PgObject<MyCKLine, MyCKPoint>{coord} {}
-
-  /**
-   * @brief
-   *
-   * @return MyCKPoint
-   */
-  constexpr auto perp() const -> MyCKPoint;
-};
+template <typename T> using BasicMyCKPoint = MyCKGeometry::Point<T>;
 
 /**
- * @brief
+ * @brief Some C-K Line
  *
- * @return MyCKLine
+ * @tparam T scalar
  */
-inline constexpr auto MyCKPoint::perp() const -> MyCKLine {
-  return MyCKLine({-2 * this->coord[0], this->coord[1], -2 * this->coord[2]});
-}
+template <typename T> using BasicMyCKLine = MyCKGeometry::Line<T>;
 
-/**
- * @brief
- *
- * @return MyCKPoint
- */
-inline constexpr auto MyCKLine::perp() const -> MyCKPoint {
-  return MyCKPoint({-this->coord[0], 2 * this->coord[1], -this->coord[2]});
-}
+using MyCKPoint = BasicMyCKPoint<int64_t>;
+using MyCKLine = BasicMyCKLine<int64_t>;
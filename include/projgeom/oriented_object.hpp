@@ -0,0 +1,378 @@
+#pragma once
+
+/** @file include/projgeom/oriented_object.hpp
+ *  Oriented projective plane: homogeneous coordinates are significant up
+ *  to a positive factor only, so p and -p are distinct (antipodal) points
+ *  and every line has a positive and a negative side.
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pg_array.hpp"
+#include "pg_object.hpp"
+#include "predicates.hpp"
+
+/**
+ * @brief Oriented Point/Line
+ *
+ * Same interface as PgObject, but two objects are equal only if their
+ * coordinates differ by a positive factor. Joins and meets are oriented:
+ * p.circ(q).side(r) is the orientation of the triple (p, q, r), i.e.
+ * r lies on the positive side of the line from p to q when p, q, r turn
+ * counterclockwise (for points with a positive last coordinate).
+ *
+ * @tparam P
+ * @tparam L
+ * @tparam T scalar of the homogeneous coordinates
+ */
+template <typename P, typename L, typename T = int64_t> struct OrientedObject {
+  using Dual = L;
+  using value_type = T;
+
+  std::array<T, 3> coord;
+
+  /**
+   * @brief Construct a new Oriented Object object
+   *
+   * @param[in] coord
+   */
+  constexpr explicit OrientedObject(std::array<T, 3> coord)
+      : coord{std::move(coord)} {}
+
+  /**
+   * @brief Equal to: proportional with a positive factor
+   *
+   * @param[in] other
+   * @return true
+   * @return false
+   */
+  friend constexpr auto operator==(const P &lhs, const P &rhs) -> bool {
+    return &lhs == &rhs
+               ? true
+               : lhs.coord[1] * rhs.coord[2] == lhs.coord[2] * rhs.coord[1] &&
+                     lhs.coord[2] * rhs.coord[0] ==
+                         lhs.coord[0] * rhs.coord[2] &&
+                     lhs.coord[0] * rhs.coord[1] ==
+                         lhs.coord[1] * rhs.coord[0] &&
+                     fun::dot_sign(lhs.coord, rhs.coord) > 0;
+  }
+
+  /**
+   * @brief Equal to
+   *
+   * @param[in] other
+   * @return true
+   * @return false
+   */
+  friend constexpr auto operator!=(const P &lhs, const P &rhs) -> bool {
+    return !(lhs == rhs);
+  }
+
+  /**
+   * @brief Antipode (the same object with the opposite orientation)
+   *
+   * @return P
+   */
+  constexpr auto operator-() const -> P {
+    return P{{-this->coord[0], -this->coord[1], -this->coord[2]}};
+  }
+
+  /**
+   * @brief
+   *
+   * @return L
+   */
+  constexpr auto aux() const -> L { return L{this->coord}; }
+
+  /**
+   * @brief
+   *
+   * @param[in] other
+   * @return T
+   */
+  constexpr auto dot(const L &other) const -> T {
+    return ::dot(this->coord, other.coord);
+  }
+
+  /**
+   * @brief
+   *
+   * @param[in] ld
+   * @param[in] p
+   * @param[in] mu
+   * @param[in] q
+   * @return P
+   */
+  static constexpr auto plucker(const T &ld, const P &p, const T &mu,
+                                const P &q) -> P {
+    return P{::plckr(ld, p.coord, mu, q.coord)};
+  }
+
+  /**
+   * @brief Incidence, through side() so that it is exact for int64
+   *
+   * @param[in] other
+   * @return true
+   * @return false
+   */
+  constexpr auto incident(const L &other) const -> bool {
+    return this->side(other) == 0;
+  }
+
+  /**
+   * @brief Signed incidence: the sign of the dot product (exact for int64)
+   *
+   * @param[in] other
+   * @return int 1 on the positive side, -1 on the negative side, 0 if
+   *         incident
+   */
+  constexpr auto side(const L &other) const -> int {
+    return fun::dot_sign(this->coord, other.coord);
+  }
+
+  /**
+   * @brief Oriented join/meet
+   *
+   * @param[in] rhs
+   * @return L
+   */
+  constexpr auto circ(const P &rhs) const -> L {
+    return L{::cross(this->coord, rhs.coord)};
+  }
+};
+
+template <typename T> class BasicOrientedPoint;
+template <typename T> class BasicOrientedLine;
+
+/**
+ * @brief Oriented Point
+ *
+ * @tparam T scalar
+ */
+template <typename T>
+class BasicOrientedPoint
+    : public OrientedObject<BasicOrientedPoint<T>, BasicOrientedLine<T>, T> {
+public:
+  /**
+   * @brief Construct a new Oriented Point object
+   *
+   * @param[in] coord Homogeneous coordinate
+   */
+  constexpr explicit BasicOrientedPoint(std::array<T, 3> coord)
+      : OrientedObject<BasicOrientedPoint<T>, BasicOrientedLine<T>, T>{
+            std::move(coord)} {}
+};
+
+/**
+ * @brief Oriented Line
+ *
+ * @tparam T scalar
+ */
+template <typename T>
+class BasicOrientedLine
+    : public OrientedObject<BasicOrientedLine<T>, BasicOrientedPoint<T>, T> {
+public:
+  /**
+   * @brief Construct a new Oriented Line object
+   *
+   * @param[in] coord Homogeneous coordinate
+   */
+  constexpr explicit BasicOrientedLine(std::array<T, 3> coord)
+      : OrientedObject<BasicOrientedLine<T>, BasicOrientedPoint<T>, T>{
+            std::move(coord)} {}
+};
+
+using OrientedPoint = BasicOrientedPoint<int64_t>;
+using OrientedLine = BasicOrientedLine<int64_t>;
+using OrientedPointArray = PgArray<OrientedPoint>;
+using OrientedLineArray = PgArray<OrientedLine>;
+
+namespace fun {
+
+/**
+ * @brief Side of each object of a batch with respect to a fixed dual
+ *        object, as packed bitmasks
+ *
+ * Bit i of word i / 64 of `pos` (`neg`) is set iff object i lies strictly
+ * on the positive (negative) side; objects in neither mask are incident.
+ */
+struct SideMasks {
+  std::size_t size{};
+  std::vector<uint64_t> pos;
+  std::vector<uint64_t> neg;
+
+  /**
+   * @brief Construct masks for n objects, all incident
+   *
+   * @param[in] n
+   */
+  explicit SideMasks(std::size_t n = 0)
+      : size{n}, pos((n + 63) / 64), neg((n + 63) / 64) {}
+
+  /**
+   * @brief Side of object i
+   *
+   * @param[in] i
+   * @return int -1, 0 or 1
+   */
+  [[nodiscard]] auto side(std::size_t i) const -> int {
+    const auto bit = uint64_t(1) << (i % 64);
+    return int((this->pos[i / 64] & bit) != 0) -
+           int((this->neg[i / 64] & bit) != 0);
+  }
+
+  /**
+   * @brief Number of objects strictly on the positive side
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto count_pos() const -> std::size_t {
+    return SideMasks::popcount(this->pos);
+  }
+
+  /**
+   * @brief Number of objects strictly on the negative side
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto count_neg() const -> std::size_t {
+    return SideMasks::popcount(this->neg);
+  }
+
+  /**
+   * @brief Number of incident objects
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto count_on() const -> std::size_t {
+    return this->size - this->count_pos() - this->count_neg();
+  }
+
+  /**
+   * @brief Indices of the objects on a given side, in increasing order
+   *
+   * @param[in] s -1, 0 or 1
+   * @return std::vector<std::size_t>
+   */
+  [[nodiscard]] auto indices(int s) const -> std::vector<std::size_t> {
+    auto res = std::vector<std::size_t>{};
+    for (std::size_t w = 0; w != this->pos.size(); ++w) {
+      auto bits = ~(this->pos[w] | this->neg[w]) & this->valid(w);
+      if (s != 0) {
+        bits = s > 0 ? this->pos[w] : this->neg[w];
+      }
+      for (; bits != 0; bits &= bits - 1) {
+        res.push_back(w * 64 + std::size_t(std::countr_zero(bits)));
+      }
+    }
+    return res;
+  }
+
+private:
+  [[nodiscard]] auto valid(std::size_t w) const -> uint64_t {
+    const auto rem = this->size - w * 64;
+    return rem >= 64 ? ~uint64_t(0) : (uint64_t(1) << rem) - 1;
+  }
+
+  static auto popcount(const std::vector<uint64_t> &words) -> std::size_t {
+    std::size_t cnt = 0;
+    for (const auto w : words) {
+      cnt += std::size_t(std::popcount(w));
+    }
+    return cnt;
+  }
+};
+
+/**
+ * @brief Sides of n int64 objects (coordinate columns) with respect to a
+ *        fixed dual triple
+ *
+ * Exact. Chunks whose dot products provably fit in int64 (the coordinate
+ * magnitudes multiply to at most 2^61) go through the SIMD sign kernel,
+ * which writes the masks directly; other chunks take the exact scalar
+ * dot_sign().
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] pos ceil(n/64) words
+ * @param[out] neg ceil(n/64) words
+ * @param[in] n
+ */
+inline void side_of(simd::ConstColumns a, const simd::Triple &b,
+                    uint64_t *pos, uint64_t *neg, std::size_t n) {
+  constexpr std::size_t chunk = 256; // a multiple of 64
+  // |b| <= 2^bbits (x ^ (x >> 63) is |x| or |x| - 1); a chunk is sent to
+  // the kernel when all |a| < 2^k with k + bbits = 61, so that
+  // |a . b| <= 3 * 2^61 fits in int64
+  const auto mag = [](int64_t x) { return uint64_t(x ^ (x >> 63)); };
+  const auto k = 61 - int(std::bit_width(mag(b[0]) | mag(b[1]) | mag(b[2])));
+  const auto off = k > 0 ? uint64_t(1) << k : 0;
+  for (std::size_t i = 0; i < n; i += chunk) {
+    const auto m = std::min(chunk, n - i);
+    auto fits = k > 0;
+    if (fits) {
+      // x in [-2^k, 2^k) iff x + 2^k in [0, 2^(k+1)); branch-free so that
+      // the scan vectorizes
+      uint64_t out = 0;
+      for (std::size_t j = i; j != i + m; ++j) {
+        out |= (uint64_t(a[0][j]) + off) | (uint64_t(a[1][j]) + off) |
+               (uint64_t(a[2][j]) + off);
+      }
+      fits = (out >> (k + 1)) == 0;
+    }
+    if (fits) {
+      simd::sign_batch({a[0] + i, a[1] + i, a[2] + i}, b, pos + i / 64,
+                       neg + i / 64, m);
+      continue;
+    }
+    for (std::size_t w = i / 64; w * 64 < i + m; ++w) {
+      uint64_t p = 0, q = 0;
+      for (std::size_t j = 0; j != 64 && w * 64 + j != n; ++j) {
+        const auto e = w * 64 + j;
+        const auto s = dot_sign(simd::Triple{a[0][e], a[1][e], a[2][e]}, b);
+        p |= uint64_t(s > 0) << j;
+        q |= uint64_t(s < 0) << j;
+      }
+      pos[w] = p;
+      neg[w] = q;
+    }
+  }
+}
+
+/**
+ * @brief Sides of a batch of objects with respect to a fixed dual object
+ *
+ * For example, classify points against a line for half-plane
+ * partitioning: side_of(l, pts).indices(1) are the points strictly on
+ * the positive side of l.
+ *
+ * @tparam P Point (or Line) type
+ * @param[in] other
+ * @param[in] objs
+ * @return SideMasks
+ */
+template <class P>
+auto side_of(const typename P::Dual &other, const PgArray<P> &objs)
+    -> SideMasks {
+  auto res = SideMasks(objs.size());
+  if constexpr (std::is_same_v<typename P::value_type, int64_t>) {
+    side_of(objs.columns(), other.coord, res.pos.data(), res.neg.data(),
+            objs.size());
+  } else {
+    for (std::size_t i = 0; i != objs.size(); ++i) {
+      const auto s = dot_sign(objs[i].coord, other.coord);
+      res.pos[i / 64] |= uint64_t(s > 0) << (i % 64);
+      res.neg[i / 64] |= uint64_t(s < 0) << (i % 64);
+    }
+  }
+  return res;
+}
+
+} // namespace fun
@@ -0,0 +1,143 @@
+#pragma once
+
+/** @file include/projgeom/parallel.hpp
+ *  Minimal work-stealing parallel_for.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace fun {
+
+namespace detail {
+
+/**
+ * @brief Deque of chunk indices: the owner pops from the front, thieves
+ *        steal from the back.
+ */
+class StealQueue {
+  std::mutex _mutex;
+  std::deque<std::size_t> _chunks;
+
+public:
+  void push_back(std::size_t chunk) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_chunks.push_back(chunk);
+  }
+
+  auto pop_front() -> std::optional<std::size_t> {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_chunks.empty()) {
+      return std::nullopt;
+    }
+    const auto chunk = this->_chunks.front();
+    this->_chunks.pop_front();
+    return chunk;
+  }
+
+  auto steal_back() -> std::optional<std::size_t> {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_chunks.empty()) {
+      return std::nullopt;
+    }
+    const auto chunk = this->_chunks.back();
+    this->_chunks.pop_back();
+    return chunk;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Number of worker threads used when none is given
+ *
+ * @return unsigned
+ */
+inline auto default_concurrency() -> unsigned {
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Run fn(begin, end) over [0, n) split into chunks of `grain`
+ *
+ * Each worker starts with a contiguous block of chunks and, once its own
+ * queue is empty, steals chunks from the back of the other queues, so
+ * unevenly priced chunks still keep every core busy. The calling thread
+ * acts as worker 0. The first exception thrown by fn is rethrown after all
+ * workers have stopped.
+ *
+ * @tparam Fn callable as fn(std::size_t begin, std::size_t end)
+ * @param[in] n
+ * @param[in] fn
+ * @param[in] grain chunk size (0: about 8 chunks per thread)
+ * @param[in] num_threads (0: default_concurrency())
+ */
+template <typename Fn>
+void parallel_for(std::size_t n, Fn &&fn, std::size_t grain = 0,
+                  unsigned num_threads = 0) {
+  if (n == 0) {
+    return;
+  }
+  if (num_threads == 0) {
+    num_threads = default_concurrency();
+  }
+  if (grain == 0) {
+    grain = std::max<std::size_t>(1, n / (std::size_t(num_threads) * 8));
+  }
+  const auto num_chunks = (n + grain - 1) / grain;
+  num_threads =
+      static_cast<unsigned>(std::min<std::size_t>(num_threads, num_chunks));
+  if (num_threads == 1) {
+    fn(std::size_t(0), n);
+    return;
+  }
+
+  std::vector<detail::StealQueue> queues(num_threads);
+  for (std::size_t c = 0; c != num_chunks; ++c) {
+    queues[c * num_threads / num_chunks].push_back(c);
+  }
+
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto worker = [&](unsigned self) {
+    while (true) {
+      auto chunk = queues[self].pop_front();
+      for (unsigned k = 1; !chunk && k != num_threads; ++k) {
+        chunk = queues[(self + k) % num_threads].steal_back();
+      }
+      if (!chunk) {
+        return;
+      }
+      const auto begin = *chunk * grain;
+      try {
+        fn(begin, std::min(n, begin + grain));
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (unsigned w = 1; w != num_threads; ++w) {
+    threads.emplace_back(worker, w);
+  }
+  worker(0);
+  for (auto &t : threads) {
+    t.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace fun
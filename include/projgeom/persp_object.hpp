@@ -3,58 +3,62 @@
 #include "ck_plane.hpp"
 #include "pg_object.hpp"
 
-class PerspPoint;
-class PerspLine;
+template <typename T> class BasicPerspPoint;
+template <typename T> class BasicPerspLine;
 
 /**
  * @brief Perspective Point
  *
+ * @tparam T scalar
  */
-class PerspPoint : public PgObject<PerspPoint, PerspLine> {
+template <typename T>
+class BasicPerspPoint
+    : public PgObject<BasicPerspPoint<T>, BasicPerspLine<T>, T> {
 public:
-  // constexpr static PerspLine L_INF{ {0, -1, 1}};
-
   /**
    * @brief Construct a new Persp Point object
    *
    * @param[in] coord Homogeneous coordinate
    */
-  constexpr explicit PerspPoint(std::array<int64_t, 3> coord)
-      : PgObject<PerspPoint, PerspLine>{coord} {}
+  constexpr explicit BasicPerspPoint(std::array<T, 3> coord)
+      : PgObject<BasicPerspPoint<T>, BasicPerspLine<T>, T>{coord} {}
 
   /**
    * @brief
    *
-   * @return const PerspLine&
+   * @return BasicPerspLine<T>
    */
-  constexpr auto perp() const -> const PerspLine &;
+  constexpr auto perp() const -> BasicPerspLine<T>;
 };
 
 /**
  * @brief Perspective Line
  *
+ * @tparam T scalar
  */
-class PerspLine : public PgObject<PerspLine, PerspPoint> {
+template <typename T>
+class BasicPerspLine
+    : public PgObject<BasicPerspLine<T>, BasicPerspPoint<T>, T> {
 public:
-  // constexpr static PerspPoint I_RE{ {0, 1, 1}};
-  // constexpr static PerspPoint I_IM{ {1, 0, 0}};
-
   /**
    * @brief Construct a new Persp Line object
    *
    * @param[in] coord Homogeneous coordinate
    */
-  constexpr explicit PerspLine(std::array<int64_t, 3> coord)
-      : PgObject<PerspLine, PerspPoint>{coord} {}
+  constexpr explicit BasicPerspLine(std::array<T, 3> coord)
+      : PgObject<BasicPerspLine<T>, BasicPerspPoint<T>, T>{coord} {}
 
   /**
    * @brief
    *
-   * @return PerspPoint
+   * @return BasicPerspPoint<T>
    */
-  constexpr auto perp() const -> PerspPoint;
+  constexpr auto perp() const -> BasicPerspPoint<T>;
 };
 
+using PerspPoint = BasicPerspPoint<int64_t>;
+using PerspLine = BasicPerspLine<int64_t>;
+
 static constexpr PerspLine L_INF({0, -1, 1});
 static constexpr PerspPoint I_RE({0, 1, 1});
 static constexpr PerspPoint I_IM({1, 0, 0});
@@ -62,15 +66,22 @@ static constexpr PerspPoint I_IM({1, 0, 0});
 /**
  * @brief
  *
- * @return const PerspLine&
+ * @return BasicPerspLine<T> the line at infinity
  */
-constexpr auto PerspPoint::perp() const -> const PerspLine & { return L_INF; }
+template <typename T>
+constexpr auto BasicPerspPoint<T>::perp() const -> BasicPerspLine<T> {
+  return BasicPerspLine<T>({T(0), T(-1), T(1)});
+}
 
 /**
  * @brief
  *
- * @return PerspPoint
+ * @return BasicPerspPoint<T>
  */
-constexpr auto PerspLine::perp() const -> PerspPoint {
-  return PerspPoint::plucker(this->dot(I_RE), I_RE, this->dot(I_IM), I_IM);
+template <typename T>
+constexpr auto BasicPerspLine<T>::perp() const -> BasicPerspPoint<T> {
+  // plucker(dot(I_RE), I_RE, dot(I_IM), I_IM) with the constants folded in
+  const auto &[a, b, c] = this->coord;
+  const auto re = b + c;
+  return BasicPerspPoint<T>({a, re, re});
 }
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "pg_object.hpp"
+#include "pg_simd.hpp"
+
+/**
+ * @brief Allocator returning storage aligned to a cache line
+ *
+ * @tparam T
+ * @tparam Align alignment in bytes
+ */
+template <typename T, std::size_t Align = 64> struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Align>;
+  };
+
+  constexpr AlignedAllocator() noexcept = default;
+
+  template <typename U>
+  constexpr AlignedAllocator(const AlignedAllocator<U, Align> &) noexcept {}
+
+  /**
+   * @brief Allocate n objects
+   *
+   * @param[in] n
+   * @return T*
+   */
+  [[nodiscard]] auto allocate(std::size_t n) -> T * {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{Align}));
+  }
+
+  /**
+   * @brief Deallocate storage obtained from allocate()
+   *
+   * @param[in] p
+   */
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t{Align});
+  }
+
+  template <typename U>
+  friend constexpr auto operator==(const AlignedAllocator &,
+                                   const AlignedAllocator<U, Align> &) -> bool {
+    return true;
+  }
+
+  template <typename U>
+  friend constexpr auto operator!=(const AlignedAllocator &,
+                                   const AlignedAllocator<U, Align> &) -> bool {
+    return false;
+  }
+};
+
+/**
+ * @brief Structure-of-arrays container of projective points/lines
+ *
+ * The homogeneous coordinates are kept in three separate, aligned columns so
+ * that batch operations stream through memory instead of gathering from
+ * array-of-structs storage. int64_t coordinates use the runtime-dispatched
+ * SIMD kernels; other scalars use plain loops.
+ *
+ * @tparam P Point (or Line) type derived from PgObject
+ */
+template <class P> class PgArray {
+public:
+  using value_type = P;
+  using Dual = PgArray<typename P::Dual>;
+  using Scalar = typename P::value_type;
+  using Column = std::vector<Scalar, AlignedAllocator<Scalar>>;
+
+  std::array<Column, 3> coord;
+
+  /**
+   * @brief Construct an empty Pg Array object
+   *
+   */
+  PgArray() = default;
+
+  /**
+   * @brief Construct a new Pg Array object with n zero objects
+   *
+   * @param[in] n
+   */
+  explicit PgArray(std::size_t n) : coord{Column(n), Column(n), Column(n)} {}
+
+  /**
+   * @brief Construct a new Pg Array object from a list of objects
+   *
+   * @param[in] objs
+   */
+  explicit PgArray(const std::vector<P> &objs) : PgArray(objs.size()) {
+    for (std::size_t i = 0; i != objs.size(); ++i) {
+      this->set(i, objs[i]);
+    }
+  }
+
+  /**
+   * @brief Number of objects
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return this->coord[0].size();
+  }
+
+  /**
+   * @brief
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto empty() const noexcept -> bool {
+    return this->coord[0].empty();
+  }
+
+  /**
+   * @brief
+   *
+   * @param[in] n
+   */
+  void reserve(std::size_t n) {
+    for (auto &col : this->coord) {
+      col.reserve(n);
+    }
+  }
+
+  /**
+   * @brief
+   *
+   * @param[in] n
+   */
+  void resize(std::size_t n) {
+    for (auto &col : this->coord) {
+      col.resize(n);
+    }
+  }
+
+  /**
+   * @brief Append an object
+   *
+   * @param[in] obj
+   */
+  void push_back(const P &obj) {
+    for (std::size_t k = 0; k != 3; ++k) {
+      this->coord[k].push_back(obj.coord[k]);
+    }
+  }
+
+  /**
+   * @brief Materialize the i-th object
+   *
+   * @param[in] i
+   * @return P
+   */
+  auto operator[](std::size_t i) const -> P {
+    return P{{this->coord[0][i], this->coord[1][i], this->coord[2][i]}};
+  }
+
+  /**
+   * @brief Overwrite the i-th object
+   *
+   * @param[in] i
+   * @param[in] obj
+   */
+  void set(std::size_t i, const P &obj) {
+    for (std::size_t k = 0; k != 3; ++k) {
+      this->coord[k][i] = obj.coord[k];
+    }
+  }
+
+  /**
+   * @brief Column pointers
+   *
+   * @return std::array<const Scalar *, 3>
+   */
+  auto columns() const -> std::array<const Scalar *, 3> {
+    return {this->coord[0].data(), this->coord[1].data(),
+            this->coord[2].data()};
+  }
+
+  /**
+   * @brief Column pointers
+   *
+   * @return std::array<Scalar *, 3>
+   */
+  auto columns() -> std::array<Scalar *, 3> {
+    return {this->coord[0].data(), this->coord[1].data(),
+            this->coord[2].data()};
+  }
+
+  /**
+   * @brief Element-wise join or meet
+   *
+   * @param[in] rhs
+   * @return Dual
+   */
+  auto circ(const PgArray &rhs) const -> Dual {
+    assert(this->size() == rhs.size());
+    auto res = Dual(this->size());
+    if constexpr (std::is_same_v<Scalar, int64_t>) {
+      fun::simd::cross_batch(this->columns(), rhs.columns(), res.columns(),
+                             this->size());
+    } else {
+      const auto a = this->columns();
+      const auto b = rhs.columns();
+      auto c = res.columns();
+      for (std::size_t i = 0; i != this->size(); ++i) {
+        c[0][i] = a[1][i] * b[2][i] - a[2][i] * b[1][i];
+        c[1][i] = a[2][i] * b[0][i] - a[0][i] * b[2][i];
+        c[2][i] = a[0][i] * b[1][i] - a[1][i] * b[0][i];
+      }
+    }
+    return res;
+  }
+
+  /**
+   * @brief Join or meet every object with a fixed one
+   *
+   * @param[in] rhs
+   * @return Dual
+   */
+  auto circ(const P &rhs) const -> Dual {
+    auto res = Dual(this->size());
+    if constexpr (std::is_same_v<Scalar, int64_t>) {
+      fun::simd::cross_batch(this->columns(), rhs.coord, res.columns(),
+                             this->size());
+    } else {
+      const auto a = this->columns();
+      const auto &b = rhs.coord;
+      auto c = res.columns();
+      for (std::size_t i = 0; i != this->size(); ++i) {
+        c[0][i] = a[1][i] * b[2] - a[2][i] * b[1];
+        c[1][i] = a[2][i] * b[0] - a[0][i] * b[2];
+        c[2][i] = a[0][i] * b[1] - a[1][i] * b[0];
+      }
+    }
+    return res;
+  }
+
+  /**
+   * @brief Element-wise dot product
+   *
+   * @param[in] other
+   * @return Column
+   */
+  auto dot(const Dual &other) const -> Column {
+    assert(this->size() == other.size());
+    auto res = Column(this->size());
+    if constexpr (std::is_same_v<Scalar, int64_t>) {
+      fun::simd::dot_batch(this->columns(), other.columns(), res.data(),
+                           this->size());
+    } else {
+      const auto a = this->columns();
+      const auto b = other.columns();
+      for (std::size_t i = 0; i != this->size(); ++i) {
+        res[i] = a[0][i] * b[0][i] + a[1][i] * b[1][i] + a[2][i] * b[2][i];
+      }
+    }
+    return res;
+  }
+
+  /**
+   * @brief Dot product of every object with a fixed dual object
+   *
+   * @param[in] other
+   * @return Column
+   */
+  auto dot(const typename P::Dual &other) const -> Column {
+    auto res = Column(this->size());
+    if constexpr (std::is_same_v<Scalar, int64_t>) {
+      fun::simd::dot_batch(this->columns(), other.coord, res.data(),
+                           this->size());
+    } else {
+      const auto a = this->columns();
+      const auto &b = other.coord;
+      for (std::size_t i = 0; i != this->size(); ++i) {
+        res[i] = a[0][i] * b[0] + a[1][i] * b[1] + a[2][i] * b[2];
+      }
+    }
+    return res;
+  }
+
+  /**
+   * @brief Element-wise incidence
+   *
+   * @param[in] other
+   * @return std::vector<uint8_t> 1 if incident, 0 otherwise
+   */
+  auto incident(const Dual &other) const -> std::vector<uint8_t> {
+    assert(this->size() == other.size());
+    return PgArray::is_zero(this->dot(other));
+  }
+
+  /**
+   * @brief Incidence of every object with a fixed dual object
+   *
+   * @param[in] other
+   * @return std::vector<uint8_t> 1 if incident, 0 otherwise
+   */
+  auto incident(const typename P::Dual &other) const -> std::vector<uint8_t> {
+    return PgArray::is_zero(this->dot(other));
+  }
+
+  /**
+   * @brief Element-wise Plucker operation
+   *
+   * @param[in] ld
+   * @param[in] p
+   * @param[in] mu
+   * @param[in] q
+   * @return PgArray
+   */
+  static auto plucker(const Column &ld, const PgArray &p, const Column &mu,
+                      const PgArray &q) -> PgArray {
+    assert(ld.size() == p.size() && mu.size() == p.size() &&
+           q.size() == p.size());
+    auto res = PgArray(p.size());
+    if constexpr (std::is_same_v<Scalar, int64_t>) {
+      fun::simd::plckr_batch(ld.data(), p.columns(), mu.data(), q.columns(),
+                             res.columns(), p.size());
+    } else {
+      for (std::size_t k = 0; k != 3; ++k) {
+        for (std::size_t i = 0; i != p.size(); ++i) {
+          res.coord[k][i] = ld[i] * p.coord[k][i] + mu[i] * q.coord[k][i];
+        }
+      }
+    }
+    return res;
+  }
+
+  /**
+   * @brief Plucker operation with common coefficients
+   *
+   * @param[in] ld
+   * @param[in] p
+   * @param[in] mu
+   * @param[in] q
+   * @return PgArray
+   */
+  static auto plucker(const Scalar &ld, const PgArray &p, const Scalar &mu,
+                      const PgArray &q) -> PgArray {
+    const auto n = p.size();
+    auto res = PgArray(n);
+    for (std::size_t k = 0; k != 3; ++k) {
+      const auto *a = p.coord[k].data();
+      const auto *b = q.coord[k].data();
+      auto *c = res.coord[k].data();
+      for (std::size_t i = 0; i != n; ++i) {
+        c[i] = ld * a[i] + mu * b[i];
+      }
+    }
+    return res;
+  }
+
+private:
+  static auto is_zero(const Column &vals) -> std::vector<uint8_t> {
+    auto res = std::vector<uint8_t>(vals.size());
+    for (std::size_t i = 0; i != vals.size(); ++i) {
+      res[i] = static_cast<uint8_t>(vals[i] == Scalar(0));
+    }
+    return res;
+  }
+};
+
+using PgPointArray = PgArray<PgPoint>;
+using PgLineArray = PgArray<PgLine>;
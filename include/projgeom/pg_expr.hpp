@@ -0,0 +1,246 @@
+#pragma once
+
+/** @file include/projgeom/pg_expr.hpp
+ *  Expression templates for chains of meet/join operations.
+ *
+ *  circ/plucker/perp on lazy operands build nodes instead of PgObjects;
+ *  evaluating the outermost node (or taking its dot product) expands the
+ *  whole chain into one straight-line kernel on std::array coordinates.
+ *  Leaves refer to their operands, so an expression must not outlive the
+ *  objects it was built from.
+ */
+
+#include <array>
+#include <type_traits>
+
+#include "pg_object.hpp"
+#include "predicates.hpp"
+
+namespace fun::expr {
+
+/**
+ * @brief Leaf: a reference to a concrete point or line
+ *
+ * @tparam Obj
+ */
+template <class Obj> struct Leaf {
+  using result_type = Obj;
+  using value_type = typename Obj::value_type;
+
+  const Obj &obj;
+
+  [[nodiscard]] constexpr auto coord() const
+      -> const std::array<value_type, 3> & {
+    return obj.coord;
+  }
+};
+
+/**
+ * @brief Join of two points / meet of two lines
+ *
+ * @tparam A
+ * @tparam B
+ */
+template <class A, class B> struct Circ {
+  using result_type = typename A::result_type::Dual;
+  using value_type = typename A::value_type;
+
+  A a;
+  B b;
+
+  [[nodiscard]] constexpr auto coord() const -> std::array<value_type, 3> {
+    return ::cross(a.coord(), b.coord());
+  }
+};
+
+/**
+ * @brief Linear combination ld p + mu q
+ *
+ * @tparam A
+ * @tparam B
+ */
+template <class A, class B> struct Plucker {
+  using result_type = typename A::result_type;
+  using value_type = typename A::value_type;
+
+  value_type ld;
+  A a;
+  value_type mu;
+  B b;
+
+  [[nodiscard]] constexpr auto coord() const -> std::array<value_type, 3> {
+    return ::plckr(ld, a.coord(), mu, b.coord());
+  }
+};
+
+/**
+ * @brief Polar of a point/line in a CK geometry
+ *
+ * @tparam A
+ */
+template <class A> struct Perp {
+  using result_type = typename A::result_type::Dual;
+  using value_type = typename A::value_type;
+
+  A a;
+
+  [[nodiscard]] constexpr auto coord() const -> std::array<value_type, 3> {
+    return typename A::result_type{a.coord()}.perp().coord;
+  }
+};
+
+template <class E> struct is_node : std::false_type {};
+template <class Obj> struct is_node<Leaf<Obj>> : std::true_type {};
+template <class A, class B> struct is_node<Circ<A, B>> : std::true_type {};
+template <class A, class B> struct is_node<Plucker<A, B>> : std::true_type {};
+template <class A> struct is_node<Perp<A>> : std::true_type {};
+
+template <class E> struct is_circ : std::false_type {};
+template <class A, class B> struct is_circ<Circ<A, B>> : std::true_type {};
+template <class E> struct is_circ<const E> : is_circ<E> {};
+
+/**
+ * @brief Wrap an object (or pass a node through)
+ *
+ * @tparam E
+ * @param[in] e
+ * @return node
+ */
+template <class E> constexpr auto lazy(const E &e) {
+  if constexpr (is_node<E>::value) {
+    return e;
+  } else {
+    return Leaf<E>{e};
+  }
+}
+
+template <class A, class B> constexpr auto circ(const A &a, const B &b) {
+  return Circ<decltype(lazy(a)), decltype(lazy(b))>{lazy(a), lazy(b)};
+}
+
+template <class T, class A, class B>
+constexpr auto plucker(const T &ld, const A &a, const T &mu, const B &b) {
+  return Plucker<decltype(lazy(a)), decltype(lazy(b))>{ld, lazy(a), mu,
+                                                       lazy(b)};
+}
+
+template <class A> constexpr auto perp(const A &a) {
+  return Perp<decltype(lazy(a))>{lazy(a)};
+}
+
+/**
+ * @brief Materialize an expression
+ *
+ * @tparam E
+ * @param[in] e
+ * @return E::result_type
+ */
+template <class E> constexpr auto eval(const E &e) {
+  const auto node = lazy(e);
+  return typename decltype(node)::result_type{node.coord()};
+}
+
+/**
+ * @brief Dot product of two expressions
+ *
+ * dot(circ(p, q), r) is the triple product det[p; q; r]: it is expanded
+ * directly instead of materializing the join p.circ(q).
+ *
+ * @tparam A
+ * @tparam B
+ * @param[in] a
+ * @param[in] b
+ * @return value_type
+ */
+template <class A, class B> constexpr auto dot(const A &a, const B &b) {
+  const auto na = lazy(a);
+  const auto nb = lazy(b);
+  if constexpr (is_circ<decltype(na)>::value) {
+    return det3(na.a.coord(), na.b.coord(), nb.coord());
+  } else if constexpr (is_circ<decltype(nb)>::value) {
+    return dot(nb, na);
+  } else {
+    return ::dot(na.coord(), nb.coord());
+  }
+}
+
+/**
+ * @brief Incidence of two expressions
+ *
+ * incident(circ(p, q), r) tests det[p; q; r] with det3_is_zero, so it is
+ * exact for int64 coordinates even when the determinant overflows.
+ *
+ * @tparam A
+ * @tparam B
+ * @param[in] a
+ * @param[in] b
+ * @return true
+ * @return false
+ */
+template <class A, class B>
+constexpr auto incident(const A &a, const B &b) -> bool {
+  const auto na = lazy(a);
+  const auto nb = lazy(b);
+  using T = typename decltype(na)::value_type;
+  if constexpr (is_circ<decltype(na)>::value) {
+    return det3_is_zero(na.a.coord(), na.b.coord(), nb.coord());
+  } else if constexpr (is_circ<decltype(nb)>::value) {
+    return incident(nb, na);
+  } else {
+    return ::dot(na.coord(), nb.coord()) == T(0);
+  }
+}
+
+/**
+ * @brief Fused coincident: one triple product
+ *
+ * @tparam P
+ * @tparam Q
+ * @tparam R
+ * @param[in] p
+ * @param[in] q
+ * @param[in] r
+ * @return true
+ * @return false
+ */
+template <class P, class Q, class R>
+constexpr auto coincident(const P &p, const Q &q, const R &r) -> bool {
+  return incident(circ(p, q), r);
+}
+
+/**
+ * @brief Fused Pappus check (same result as fun::check_pappus)
+ *
+ * @tparam P Point
+ * @param[in] co1
+ * @param[in] co2
+ * @return true
+ * @return false
+ */
+template <class P>
+constexpr auto check_pappus(const std::array<P, 3> &co1,
+                            const std::array<P, 3> &co2) -> bool {
+  const auto &[a, b, c] = co1;
+  const auto &[d, e, f] = co2;
+  const auto g = circ(circ(a, e), circ(b, d));
+  const auto h = circ(circ(a, f), circ(c, d));
+  const auto i = circ(circ(b, f), circ(c, e));
+  return coincident(g, h, i);
+}
+
+/**
+ * @brief Fused orthocenter (same result as fun::orthocenter)
+ *
+ * @tparam P Point of a CK geometry
+ * @param[in] tri
+ * @return P
+ */
+template <class P>
+constexpr auto orthocenter(const std::array<P, 3> &tri) -> P {
+  const auto &[a1, a2, a3] = tri;
+  const auto t1 = circ(perp(circ(a2, a3)), a1);
+  const auto t2 = circ(perp(circ(a3, a1)), a2);
+  return eval(circ(t1, t2));
+}
+
+} // namespace fun::expr
@@ -9,25 +9,28 @@
 /**
  * @brief Dot product
  *
+ * @tparam T scalar
  * @param[in] a
  * @param[in] b
- * @return int64_t
+ * @return T
  */
-constexpr auto dot(const std::array<int64_t, 3> &a,
-                   const std::array<int64_t, 3> &b) -> int64_t {
+template <typename T>
+constexpr auto dot(const std::array<T, 3> &a, const std::array<T, 3> &b)
+    -> T {
   return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
 }
 
 /**
  * @brief Cross product
  *
+ * @tparam T scalar
  * @param[in] a
  * @param[in] b
- * @return std::array<int64_t, 3>
+ * @return std::array<T, 3>
  */
-constexpr auto cross(const std::array<int64_t, 3> &a,
-                     const std::array<int64_t, 3> &b)
-    -> std::array<int64_t, 3> {
+template <typename T>
+constexpr auto cross(const std::array<T, 3> &a, const std::array<T, 3> &b)
+    -> std::array<T, 3> {
   return {
       a[1] * b[2] - a[2] * b[1],
       a[2] * b[0] - a[0] * b[2],
@@ -38,15 +41,16 @@ constexpr auto cross(const std::array<int64_t, 3> &a,
 /**
  * @brief Plucker operation
  *
+ * @tparam T scalar
  * @param[in] ld
  * @param[in] p
  * @param[in] mu
  * @param[in] q
- * @return std::array<int64_t, 3>
+ * @return std::array<T, 3>
  */
-constexpr auto plckr(const int64_t &ld, const std::array<int64_t, 3> &p,
-                     const int64_t &mu, const std::array<int64_t, 3> &q)
-    -> std::array<int64_t, 3> {
+template <typename T>
+constexpr auto plckr(const T &ld, const std::array<T, 3> &p, const T &mu,
+                     const std::array<T, 3> &q) -> std::array<T, 3> {
   return {
       ld * p[0] + mu * q[0],
       ld * p[1] + mu * q[1],
@@ -59,18 +63,20 @@ constexpr auto plckr(const int64_t &ld, const std::array<int64_t, 3> &p,
  *
  * @tparam P
  * @tparam L
+ * @tparam T scalar of the homogeneous coordinates
  */
-template <typename P, typename L> struct PgObject {
+template <typename P, typename L, typename T = int64_t> struct PgObject {
   using Dual = L;
+  using value_type = T;
 
-  std::array<int64_t, 3> coord;
+  std::array<T, 3> coord;
 
   /**
    * @brief Construct a new Pg Object object
    *
    * @param[in] coord
    */
-  constexpr explicit PgObject(std::array<int64_t, 3> coord)
+  constexpr explicit PgObject(std::array<T, 3> coord)
       : coord{std::move(coord)} {}
 
   /**
@@ -111,9 +117,9 @@ template <typename P, typename L> struct PgObject {
    * @brief
    *
    * @param[in] other
-   * @return int64_t
+   * @return T
    */
-  constexpr auto dot(const L &other) const -> int64_t {
+  constexpr auto dot(const L &other) const -> T {
     return ::dot(this->coord, other.coord);
   }
 
@@ -126,8 +132,8 @@ template <typename P, typename L> struct PgObject {
    * @param[in] q
    * @return P
    */
-  static constexpr auto plucker(const int64_t &ld, const P &p,
-                                const int64_t &mu, const P &q) -> P {
+  static constexpr auto plucker(const T &ld, const P &p, const T &mu,
+                                const P &q) -> P {
     return P{::plckr(ld, p.coord, mu, q.coord)};
   }
 
@@ -139,7 +145,7 @@ template <typename P, typename L> struct PgObject {
    * @return false
    */
   constexpr auto incident(const L &other) const -> bool {
-    return this->dot(other) == 0;
+    return this->dot(other) == T(0);
   }
 
   /**
@@ -153,35 +159,42 @@ template <typename P, typename L> struct PgObject {
   }
 };
 
-class PgPoint;
-class PgLine;
+template <typename T> class BasicPgPoint;
+template <typename T> class BasicPgLine;
 
 /**
  * @brief PG Point
  *
+ * @tparam T scalar
  */
-class PgPoint : public PgObject<PgPoint, PgLine> {
+template <typename T>
+class BasicPgPoint : public PgObject<BasicPgPoint<T>, BasicPgLine<T>, T> {
 public:
   /**
    * @brief Construct a new Pg Point object
    *
    * @param[in] coord Homogeneous coordinate
    */
-  constexpr explicit PgPoint(std::array<int64_t, 3> coord)
-      : PgObject<PgPoint, PgLine>{std::move(coord)} {}
+  constexpr explicit BasicPgPoint(std::array<T, 3> coord)
+      : PgObject<BasicPgPoint<T>, BasicPgLine<T>, T>{std::move(coord)} {}
 };
 
 /**
  * @brief PG Line
  *
+ * @tparam T scalar
  */
-class PgLine : public PgObject<PgLine, PgPoint> {
+template <typename T>
+class BasicPgLine : public PgObject<BasicPgLine<T>, BasicPgPoint<T>, T> {
 public:
   /**
    * @brief Construct a new Pg Line object
    *
    * @param[in] coord Homogeneous coordinate
    */
-  constexpr explicit PgLine(std::array<int64_t, 3> coord)
-      : PgObject<PgLine, PgPoint>{std::move(coord)} {}
+  constexpr explicit BasicPgLine(std::array<T, 3> coord)
+      : PgObject<BasicPgLine<T>, BasicPgPoint<T>, T>{std::move(coord)} {}
 };
+
+using PgPoint = BasicPgPoint<int64_t>;
+using PgLine = BasicPgLine<int64_t>;
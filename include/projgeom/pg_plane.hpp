@@ -3,6 +3,8 @@
 #include <array>
 #include <cassert>
 
+#include "predicates.hpp"
+
 #if __cpp_concepts >= 201907L
 #include "pg_concepts.hpp"
 #endif
@@ -37,6 +39,9 @@ inline auto check_axiom(const P &p, const P &q, const L &l) -> bool {
 /**
  * @brief Coincident
  *
+ * Tests the triple product det[p; q; r] directly (see predicates.hpp)
+ * instead of materializing the line p.circ(q).
+ *
  * @tparam P
  * @param[in] p
  * @param[in] q
@@ -49,7 +54,7 @@ template <class P, class L = typename P::Dual>
   requires ProjPlanePrimDual<P, L>
 #endif
 inline constexpr auto coincident(const P &p, const P &q, const P &r) -> bool {
-  return p.circ(q).incident(r);
+  return det3_is_zero(p.coord, q.coord, r.coord);
 }
 
 /**
@@ -111,8 +116,8 @@ inline constexpr auto persp(const std::array<P, 3> &tri1,
                             const std::array<P, 3> &tri2) -> bool {
   const auto &[a, b, c] = tri1;
   const auto &[d, e, f] = tri2;
-  const auto &o = a.circ(d).circ(b.circ(e));
-  return c.circ(f).incident(o);
+  // the lines ad, be and cf are concurrent
+  return coincident(a.circ(d), b.circ(e), c.circ(f));
 }
 
 /**
@@ -190,7 +195,8 @@ inline constexpr auto harm_conj(const P &a, const P &b, const P &c) -> P {
   assert(coincident(a, b, c));
   const auto ab = a.circ(b);
   const auto lc = ab.aux().circ(c);
-  return P::plucker(lc.dot(a), a, lc.dot(b), b);
+  // c ~ (lc.b) a - (lc.a) b, so its conjugate is (lc.b) a + (lc.a) b
+  return P::plucker(lc.dot(b), a, lc.dot(a), b);
 }
 
 /**
@@ -212,7 +218,7 @@ inline constexpr auto involution(const P &origin, const L &mirror, const P &p)
     -> P {
   const auto po = p.circ(origin);
   const auto b = po.circ(mirror);
-  return harm_conj(origin, b, p);
+  return harm_conj<V>(origin, b, p);
 }
 
 /*
@@ -0,0 +1,649 @@
+#pragma once
+
+/** @file include/projgeom/pg_simd.hpp
+ *  Runtime-dispatched batch kernels for cross, dot, plckr, det3, dot-sign
+ *  masks and 3x3 transforms over int64 coordinate columns (scalar
+ *  fallback, AVX2, AVX-512).
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+#define PROJGEOM_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define PROJGEOM_SIMD_X86 0
+#endif
+
+namespace fun::simd {
+
+/**  Instruction set of a kernel table */
+enum class Isa { Scalar, Avx2, Avx512 };
+
+using ConstColumns = std::array<const int64_t *, 3>;
+using Columns = std::array<int64_t *, 3>;
+using Triple = std::array<int64_t, 3>;
+using Matrix = std::array<Triple, 3>; // row-major
+
+/**
+ * @brief Table of batch kernels for one instruction set
+ *
+ * All kernels process n elements; coordinate columns are passed as three
+ * pointers (structure-of-arrays). Results wrap on overflow exactly like the
+ * scalar ::cross, ::dot and ::plckr.
+ */
+struct Kernels {
+  Isa isa;
+  /** c = a x b */
+  void (*cross)(ConstColumns a, ConstColumns b, Columns c, std::size_t n);
+  /** c = a x b for a fixed b */
+  void (*cross1)(ConstColumns a, const Triple &b, Columns c, std::size_t n);
+  /** c = a . b */
+  void (*dot)(ConstColumns a, ConstColumns b, int64_t *c, std::size_t n);
+  /** c = a . b for a fixed b */
+  void (*dot1)(ConstColumns a, const Triple &b, int64_t *c, std::size_t n);
+  /** r = ld * p + mu * q */
+  void (*plckr)(const int64_t *ld, ConstColumns p, const int64_t *mu,
+                ConstColumns q, Columns r, std::size_t n);
+  /** d = det[a; b; c] = a . (b x c) */
+  void (*det3)(ConstColumns a, ConstColumns b, ConstColumns c, int64_t *d,
+               std::size_t n);
+  /** bit i of pos/neg (word i / 64) = a_i . b > 0 / < 0; fills ceil(n/64)
+   *  words, unused high bits of the last word are zero */
+  void (*sign1)(ConstColumns a, const Triple &b, uint64_t *pos, uint64_t *neg,
+                std::size_t n);
+  /** c = m a (c may alias a) */
+  void (*xform)(ConstColumns a, const Matrix &m, Columns c, std::size_t n);
+};
+
+namespace detail {
+
+inline void cross_scalar(ConstColumns a, ConstColumns b, Columns c,
+                         std::size_t n) {
+  for (std::size_t i = 0; i != n; ++i) {
+    c[0][i] = a[1][i] * b[2][i] - a[2][i] * b[1][i];
+    c[1][i] = a[2][i] * b[0][i] - a[0][i] * b[2][i];
+    c[2][i] = a[0][i] * b[1][i] - a[1][i] * b[0][i];
+  }
+}
+
+inline void cross1_scalar(ConstColumns a, const Triple &b, Columns c,
+                          std::size_t n) {
+  for (std::size_t i = 0; i != n; ++i) {
+    c[0][i] = a[1][i] * b[2] - a[2][i] * b[1];
+    c[1][i] = a[2][i] * b[0] - a[0][i] * b[2];
+    c[2][i] = a[0][i] * b[1] - a[1][i] * b[0];
+  }
+}
+
+inline void dot_scalar(ConstColumns a, ConstColumns b, int64_t *c,
+                       std::size_t n) {
+  for (std::size_t i = 0; i != n; ++i) {
+    c[i] = a[0][i] * b[0][i] + a[1][i] * b[1][i] + a[2][i] * b[2][i];
+  }
+}
+
+inline void dot1_scalar(ConstColumns a, const Triple &b, int64_t *c,
+                        std::size_t n) {
+  for (std::size_t i = 0; i != n; ++i) {
+    c[i] = a[0][i] * b[0] + a[1][i] * b[1] + a[2][i] * b[2];
+  }
+}
+
+inline void plckr_scalar(const int64_t *ld, ConstColumns p, const int64_t *mu,
+                         ConstColumns q, Columns r, std::size_t n) {
+  for (std::size_t i = 0; i != n; ++i) {
+    r[0][i] = ld[i] * p[0][i] + mu[i] * q[0][i];
+    r[1][i] = ld[i] * p[1][i] + mu[i] * q[1][i];
+    r[2][i] = ld[i] * p[2][i] + mu[i] * q[2][i];
+  }
+}
+
+inline void det3_scalar(ConstColumns a, ConstColumns b, ConstColumns c,
+                        int64_t *d, std::size_t n) {
+  for (std::size_t i = 0; i != n; ++i) {
+    d[i] = a[0][i] * (b[1][i] * c[2][i] - b[2][i] * c[1][i]) +
+           a[1][i] * (b[2][i] * c[0][i] - b[0][i] * c[2][i]) +
+           a[2][i] * (b[0][i] * c[1][i] - b[1][i] * c[0][i]);
+  }
+}
+
+inline void sign1_scalar(ConstColumns a, const Triple &b, uint64_t *pos,
+                         uint64_t *neg, std::size_t n) {
+  for (std::size_t w = 0; w * 64 < n; ++w) {
+    uint64_t p = 0, q = 0;
+    for (std::size_t j = 0; j != 64 && w * 64 + j != n; ++j) {
+      const auto i = w * 64 + j;
+      const auto d = a[0][i] * b[0] + a[1][i] * b[1] + a[2][i] * b[2];
+      p |= uint64_t(d > 0) << j;
+      q |= uint64_t(d < 0) << j;
+    }
+    pos[w] = p;
+    neg[w] = q;
+  }
+}
+
+inline void xform_scalar(ConstColumns a, const Matrix &m, Columns c,
+                         std::size_t n) {
+  const auto m0 = m[0], m1 = m[1], m2 = m[2]; // c may alias m
+  for (std::size_t i = 0; i != n; ++i) {
+    const auto x = a[0][i], y = a[1][i], z = a[2][i];
+    c[0][i] = m0[0] * x + m0[1] * y + m0[2] * z;
+    c[1][i] = m1[0] * x + m1[1] * y + m1[2] * z;
+    c[2][i] = m2[0] * x + m2[1] * y + m2[2] * z;
+  }
+}
+
+#if PROJGEOM_SIMD_X86
+
+/**
+ * @brief 64-bit low multiply on AVX2 (no vpmullq before AVX-512DQ)
+ */
+__attribute__((target("avx2"))) inline auto mullo_avx2(__m256i a, __m256i b)
+    -> __m256i {
+  const auto bswap = _mm256_shuffle_epi32(b, 0xB1);
+  const auto cross_terms = _mm256_mullo_epi32(a, bswap);
+  const auto sum = _mm256_add_epi32(_mm256_srli_epi64(cross_terms, 32),
+                                    cross_terms);
+  return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(sum, 32));
+}
+
+__attribute__((target("avx2"))) inline auto load_avx2(const int64_t *p)
+    -> __m256i {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+__attribute__((target("avx2"))) inline void store_avx2(int64_t *p, __m256i v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+}
+
+__attribute__((target("avx2"))) inline void
+cross_avx2(ConstColumns a, ConstColumns b, Columns c, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto a0 = load_avx2(a[0] + i), a1 = load_avx2(a[1] + i),
+               a2 = load_avx2(a[2] + i);
+    const auto b0 = load_avx2(b[0] + i), b1 = load_avx2(b[1] + i),
+               b2 = load_avx2(b[2] + i);
+    store_avx2(c[0] + i,
+               _mm256_sub_epi64(mullo_avx2(a1, b2), mullo_avx2(a2, b1)));
+    store_avx2(c[1] + i,
+               _mm256_sub_epi64(mullo_avx2(a2, b0), mullo_avx2(a0, b2)));
+    store_avx2(c[2] + i,
+               _mm256_sub_epi64(mullo_avx2(a0, b1), mullo_avx2(a1, b0)));
+  }
+  cross_scalar({a[0] + i, a[1] + i, a[2] + i}, {b[0] + i, b[1] + i, b[2] + i},
+               {c[0] + i, c[1] + i, c[2] + i}, n - i);
+}
+
+__attribute__((target("avx2"))) inline void
+cross1_avx2(ConstColumns a, const Triple &b, Columns c, std::size_t n) {
+  const auto b0 = _mm256_set1_epi64x(b[0]), b1 = _mm256_set1_epi64x(b[1]),
+             b2 = _mm256_set1_epi64x(b[2]);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto a0 = load_avx2(a[0] + i), a1 = load_avx2(a[1] + i),
+               a2 = load_avx2(a[2] + i);
+    store_avx2(c[0] + i,
+               _mm256_sub_epi64(mullo_avx2(a1, b2), mullo_avx2(a2, b1)));
+    store_avx2(c[1] + i,
+               _mm256_sub_epi64(mullo_avx2(a2, b0), mullo_avx2(a0, b2)));
+    store_avx2(c[2] + i,
+               _mm256_sub_epi64(mullo_avx2(a0, b1), mullo_avx2(a1, b0)));
+  }
+  cross1_scalar({a[0] + i, a[1] + i, a[2] + i}, b,
+                {c[0] + i, c[1] + i, c[2] + i}, n - i);
+}
+
+__attribute__((target("avx2"))) inline void
+dot_avx2(ConstColumns a, ConstColumns b, int64_t *c, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto s0 = mullo_avx2(load_avx2(a[0] + i), load_avx2(b[0] + i));
+    const auto s1 = mullo_avx2(load_avx2(a[1] + i), load_avx2(b[1] + i));
+    const auto s2 = mullo_avx2(load_avx2(a[2] + i), load_avx2(b[2] + i));
+    store_avx2(c + i, _mm256_add_epi64(_mm256_add_epi64(s0, s1), s2));
+  }
+  dot_scalar({a[0] + i, a[1] + i, a[2] + i}, {b[0] + i, b[1] + i, b[2] + i},
+             c + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline void
+dot1_avx2(ConstColumns a, const Triple &b, int64_t *c, std::size_t n) {
+  const auto b0 = _mm256_set1_epi64x(b[0]), b1 = _mm256_set1_epi64x(b[1]),
+             b2 = _mm256_set1_epi64x(b[2]);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto s0 = mullo_avx2(load_avx2(a[0] + i), b0);
+    const auto s1 = mullo_avx2(load_avx2(a[1] + i), b1);
+    const auto s2 = mullo_avx2(load_avx2(a[2] + i), b2);
+    store_avx2(c + i, _mm256_add_epi64(_mm256_add_epi64(s0, s1), s2));
+  }
+  dot1_scalar({a[0] + i, a[1] + i, a[2] + i}, b, c + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline void
+plckr_avx2(const int64_t *ld, ConstColumns p, const int64_t *mu,
+           ConstColumns q, Columns r, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto l = load_avx2(ld + i), m = load_avx2(mu + i);
+    for (std::size_t k = 0; k != 3; ++k) {
+      store_avx2(r[k] + i,
+                 _mm256_add_epi64(mullo_avx2(l, load_avx2(p[k] + i)),
+                                  mullo_avx2(m, load_avx2(q[k] + i))));
+    }
+  }
+  plckr_scalar(ld + i, {p[0] + i, p[1] + i, p[2] + i}, mu + i,
+               {q[0] + i, q[1] + i, q[2] + i}, {r[0] + i, r[1] + i, r[2] + i},
+               n - i);
+}
+
+__attribute__((target("avx2"))) inline void
+det3_avx2(ConstColumns a, ConstColumns b, ConstColumns c, int64_t *d,
+          std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto b0 = load_avx2(b[0] + i), b1 = load_avx2(b[1] + i),
+               b2 = load_avx2(b[2] + i);
+    const auto c0 = load_avx2(c[0] + i), c1 = load_avx2(c[1] + i),
+               c2 = load_avx2(c[2] + i);
+    const auto m0 = _mm256_sub_epi64(mullo_avx2(b1, c2), mullo_avx2(b2, c1));
+    const auto m1 = _mm256_sub_epi64(mullo_avx2(b2, c0), mullo_avx2(b0, c2));
+    const auto m2 = _mm256_sub_epi64(mullo_avx2(b0, c1), mullo_avx2(b1, c0));
+    const auto s0 = mullo_avx2(load_avx2(a[0] + i), m0);
+    const auto s1 = mullo_avx2(load_avx2(a[1] + i), m1);
+    const auto s2 = mullo_avx2(load_avx2(a[2] + i), m2);
+    store_avx2(d + i, _mm256_add_epi64(_mm256_add_epi64(s0, s1), s2));
+  }
+  det3_scalar({a[0] + i, a[1] + i, a[2] + i}, {b[0] + i, b[1] + i, b[2] + i},
+              {c[0] + i, c[1] + i, c[2] + i}, d + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline void
+sign1_avx2(ConstColumns a, const Triple &b, uint64_t *pos, uint64_t *neg,
+           std::size_t n) {
+  const auto b0 = _mm256_set1_epi64x(b[0]), b1 = _mm256_set1_epi64x(b[1]),
+             b2 = _mm256_set1_epi64x(b[2]);
+  const auto zero = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    uint64_t p = 0, q = 0;
+    for (std::size_t j = 0; j != 64; j += 4) {
+      const auto s0 = mullo_avx2(load_avx2(a[0] + i + j), b0);
+      const auto s1 = mullo_avx2(load_avx2(a[1] + i + j), b1);
+      const auto s2 = mullo_avx2(load_avx2(a[2] + i + j), b2);
+      const auto d = _mm256_add_epi64(_mm256_add_epi64(s0, s1), s2);
+      const auto gt = _mm256_cmpgt_epi64(d, zero);
+      // the sign bit of each lane is exactly "d < 0"
+      p |= uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(gt))) << j;
+      q |= uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(d))) << j;
+    }
+    pos[i / 64] = p;
+    neg[i / 64] = q;
+  }
+  sign1_scalar({a[0] + i, a[1] + i, a[2] + i}, b, pos + i / 64, neg + i / 64,
+               n - i);
+}
+
+__attribute__((target("avx2"))) inline void
+xform_avx2(ConstColumns a, const Matrix &m, Columns c, std::size_t n) {
+  __m256i mv[3][3];
+  for (std::size_t r = 0; r != 3; ++r) {
+    for (std::size_t k = 0; k != 3; ++k) {
+      mv[r][k] = _mm256_set1_epi64x(m[r][k]);
+    }
+  }
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto x = load_avx2(a[0] + i), y = load_avx2(a[1] + i),
+               z = load_avx2(a[2] + i);
+    __m256i res[3];
+    for (std::size_t r = 0; r != 3; ++r) {
+      res[r] = _mm256_add_epi64(
+          _mm256_add_epi64(mullo_avx2(mv[r][0], x), mullo_avx2(mv[r][1], y)),
+          mullo_avx2(mv[r][2], z));
+    }
+    for (std::size_t r = 0; r != 3; ++r) {
+      store_avx2(c[r] + i, res[r]);
+    }
+  }
+  xform_scalar({a[0] + i, a[1] + i, a[2] + i}, m,
+               {c[0] + i, c[1] + i, c[2] + i}, n - i);
+}
+
+#define PROJGEOM_AVX512 target("avx512f,avx512dq")
+
+__attribute__((PROJGEOM_AVX512)) inline auto load_avx512(const int64_t *p)
+    -> __m512i {
+  return _mm512_loadu_si512(p);
+}
+
+__attribute__((PROJGEOM_AVX512)) inline void store_avx512(int64_t *p,
+                                                          __m512i v) {
+  _mm512_storeu_si512(p, v);
+}
+
+__attribute__((PROJGEOM_AVX512)) inline void
+cross_avx512(ConstColumns a, ConstColumns b, Columns c, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const auto a0 = load_avx512(a[0] + i), a1 = load_avx512(a[1] + i),
+               a2 = load_avx512(a[2] + i);
+    const auto b0 = load_avx512(b[0] + i), b1 = load_avx512(b[1] + i),
+               b2 = load_avx512(b[2] + i);
+    store_avx512(c[0] + i, _mm512_sub_epi64(_mm512_mullo_epi64(a1, b2),
+                                            _mm512_mullo_epi64(a2, b1)));
+    store_avx512(c[1] + i, _mm512_sub_epi64(_mm512_mullo_epi64(a2, b0),
+                                            _mm512_mullo_epi64(a0, b2)));
+    store_avx512(c[2] + i, _mm512_sub_epi64(_mm512_mullo_epi64(a0, b1),
+                                            _mm512_mullo_epi64(a1, b0)));
+  }
+  cross_scalar({a[0] + i, a[1] + i, a[2] + i}, {b[0] + i, b[1] + i, b[2] + i},
+               {c[0] + i, c[1] + i, c[2] + i}, n - i);
+}
+
+__attribute__((PROJGEOM_AVX512)) inline void
+cross1_avx512(ConstColumns a, const Triple &b, Columns c, std::size_t n) {
+  const auto b0 = _mm512_set1_epi64(b[0]), b1 = _mm512_set1_epi64(b[1]),
+             b2 = _mm512_set1_epi64(b[2]);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const auto a0 = load_avx512(a[0] + i), a1 = load_avx512(a[1] + i),
+               a2 = load_avx512(a[2] + i);
+    store_avx512(c[0] + i, _mm512_sub_epi64(_mm512_mullo_epi64(a1, b2),
+                                            _mm512_mullo_epi64(a2, b1)));
+    store_avx512(c[1] + i, _mm512_sub_epi64(_mm512_mullo_epi64(a2, b0),
+                                            _mm512_mullo_epi64(a0, b2)));
+    store_avx512(c[2] + i, _mm512_sub_epi64(_mm512_mullo_epi64(a0, b1),
+                                            _mm512_mullo_epi64(a1, b0)));
+  }
+  cross1_scalar({a[0] + i, a[1] + i, a[2] + i}, b,
+                {c[0] + i, c[1] + i, c[2] + i}, n - i);
+}
+
+__attribute__((PROJGEOM_AVX512)) inline void
+dot_avx512(ConstColumns a, ConstColumns b, int64_t *c, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const auto s0 =
+        _mm512_mullo_epi64(load_avx512(a[0] + i), load_avx512(b[0] + i));
+    const auto s1 =
+        _mm512_mullo_epi64(load_avx512(a[1] + i), load_avx512(b[1] + i));
+    const auto s2 =
+        _mm512_mullo_epi64(load_avx512(a[2] + i), load_avx512(b[2] + i));
+    store_avx512(c + i, _mm512_add_epi64(_mm512_add_epi64(s0, s1), s2));
+  }
+  dot_scalar({a[0] + i, a[1] + i, a[2] + i}, {b[0] + i, b[1] + i, b[2] + i},
+             c + i, n - i);
+}
+
+__attribute__((PROJGEOM_AVX512)) inline void
+dot1_avx512(ConstColumns a, const Triple &b, int64_t *c, std::size_t n) {
+  const auto b0 = _mm512_set1_epi64(b[0]), b1 = _mm512_set1_epi64(b[1]),
+             b2 = _mm512_set1_epi64(b[2]);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const auto s0 = _mm512_mullo_epi64(load_avx512(a[0] + i), b0);
+    const auto s1 = _mm512_mullo_epi64(load_avx512(a[1] + i), b1);
+    const auto s2 = _mm512_mullo_epi64(load_avx512(a[2] + i), b2);
+    store_avx512(c + i, _mm512_add_epi64(_mm512_add_epi64(s0, s1), s2));
+  }
+  dot1_scalar({a[0] + i, a[1] + i, a[2] + i}, b, c + i, n - i);
+}
+
+__attribute__((PROJGEOM_AVX512)) inline void
+plckr_avx512(const int64_t *ld, ConstColumns p, const int64_t *mu,
+             ConstColumns q, Columns r, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const auto l = load_avx512(ld + i), m = load_avx512(mu + i);
+    for (std::size_t k = 0; k != 3; ++k) {
+      store_avx512(r[k] + i, _mm512_add_epi64(
+                                 _mm512_mullo_epi64(l, load_avx512(p[k] + i)),
+                                 _mm512_mullo_epi64(m, load_avx512(q[k] + i))));
+    }
+  }
+  plckr_scalar(ld + i, {p[0] + i, p[1] + i, p[2] + i}, mu + i,
+               {q[0] + i, q[1] + i, q[2] + i}, {r[0] + i, r[1] + i, r[2] + i},
+               n - i);
+}
+
+__attribute__((PROJGEOM_AVX512)) inline void
+det3_avx512(ConstColumns a, ConstColumns b, ConstColumns c, int64_t *d,
+            std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const auto b0 = load_avx512(b[0] + i), b1 = load_avx512(b[1] + i),
+               b2 = load_avx512(b[2] + i);
+    const auto c0 = load_avx512(c[0] + i), c1 = load_avx512(c[1] + i),
+               c2 = load_avx512(c[2] + i);
+    const auto m0 = _mm512_sub_epi64(_mm512_mullo_epi64(b1, c2),
+                                     _mm512_mullo_epi64(b2, c1));
+    const auto m1 = _mm512_sub_epi64(_mm512_mullo_epi64(b2, c0),
+                                     _mm512_mullo_epi64(b0, c2));
+    const auto m2 = _mm512_sub_epi64(_mm512_mullo_epi64(b0, c1),
+                                     _mm512_mullo_epi64(b1, c0));
+    const auto s0 = _mm512_mullo_epi64(load_avx512(a[0] + i), m0);
+    const auto s1 = _mm512_mullo_epi64(load_avx512(a[1] + i), m1);
+    const auto s2 = _mm512_mullo_epi64(load_avx512(a[2] + i), m2);
+    store_avx512(d + i, _mm512_add_epi64(_mm512_add_epi64(s0, s1), s2));
+  }
+  det3_scalar({a[0] + i, a[1] + i, a[2] + i}, {b[0] + i, b[1] + i, b[2] + i},
+              {c[0] + i, c[1] + i, c[2] + i}, d + i, n - i);
+}
+
+__attribute__((PROJGEOM_AVX512)) inline void
+sign1_avx512(ConstColumns a, const Triple &b, uint64_t *pos, uint64_t *neg,
+             std::size_t n) {
+  const auto b0 = _mm512_set1_epi64(b[0]), b1 = _mm512_set1_epi64(b[1]),
+             b2 = _mm512_set1_epi64(b[2]);
+  const auto zero = _mm512_setzero_si512();
+  std::size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    uint64_t p = 0, q = 0;
+    for (std::size_t j = 0; j != 64; j += 8) {
+      const auto s0 = _mm512_mullo_epi64(load_avx512(a[0] + i + j), b0);
+      const auto s1 = _mm512_mullo_epi64(load_avx512(a[1] + i + j), b1);
+      const auto s2 = _mm512_mullo_epi64(load_avx512(a[2] + i + j), b2);
+      const auto d = _mm512_add_epi64(_mm512_add_epi64(s0, s1), s2);
+      p |= uint64_t(_mm512_cmpgt_epi64_mask(d, zero)) << j;
+      q |= uint64_t(_mm512_cmplt_epi64_mask(d, zero)) << j;
+    }
+    pos[i / 64] = p;
+    neg[i / 64] = q;
+  }
+  sign1_scalar({a[0] + i, a[1] + i, a[2] + i}, b, pos + i / 64, neg + i / 64,
+               n - i);
+}
+
+#undef PROJGEOM_AVX512
+
+#endif // PROJGEOM_SIMD_X86
+
+} // namespace detail
+
+/**
+ * @brief Best instruction set supported by the running CPU
+ *
+ * @return Isa
+ */
+inline auto detect_isa() -> Isa {
+#if PROJGEOM_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+    return Isa::Avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return Isa::Avx2;
+  }
+#endif
+  return Isa::Scalar;
+}
+
+/**
+ * @brief Kernel table for a given instruction set
+ *
+ * Requests for an instruction set the CPU lacks fall back to the best
+ * supported one.
+ *
+ * @param[in] isa
+ * @return const Kernels&
+ */
+inline auto kernels_for(Isa isa) -> const Kernels & {
+  static constexpr Kernels scalar{
+      Isa::Scalar,         detail::cross_scalar, detail::cross1_scalar,
+      detail::dot_scalar,  detail::dot1_scalar,  detail::plckr_scalar,
+      detail::det3_scalar, detail::sign1_scalar, detail::xform_scalar};
+#if PROJGEOM_SIMD_X86
+  static constexpr Kernels avx2{
+      Isa::Avx2,         detail::cross_avx2, detail::cross1_avx2,
+      detail::dot_avx2,  detail::dot1_avx2,  detail::plckr_avx2,
+      detail::det3_avx2, detail::sign1_avx2, detail::xform_avx2};
+  // vpmullq made an AVX-512 xform slower than both the AVX2 kernel and the
+  // scalar loop, so AVX-512 machines keep the AVX2 one
+  static constexpr Kernels avx512{
+      Isa::Avx512,         detail::cross_avx512, detail::cross1_avx512,
+      detail::dot_avx512,  detail::dot1_avx512,  detail::plckr_avx512,
+      detail::det3_avx512, detail::sign1_avx512, detail::xform_avx2};
+  static const Isa best = detect_isa();
+  if (isa > best) {
+    isa = best;
+  }
+  switch (isa) {
+  case Isa::Avx512:
+    return avx512;
+  case Isa::Avx2:
+    return avx2;
+  default:
+    break;
+  }
+#else
+  (void)isa;
+#endif
+  return scalar;
+}
+
+/**
+ * @brief Kernel table of the running CPU, selected once via CPUID
+ *
+ * @return const Kernels&
+ */
+inline auto kernels() -> const Kernels & {
+  static const Kernels &table = kernels_for(detect_isa());
+  return table;
+}
+
+/**
+ * @brief Batch cross product
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] c
+ * @param[in] n
+ */
+inline void cross_batch(ConstColumns a, ConstColumns b, Columns c,
+                        std::size_t n) {
+  kernels().cross(a, b, c, n);
+}
+
+/**
+ * @brief Batch cross product with a fixed right operand
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] c
+ * @param[in] n
+ */
+inline void cross_batch(ConstColumns a, const Triple &b, Columns c,
+                        std::size_t n) {
+  kernels().cross1(a, b, c, n);
+}
+
+/**
+ * @brief Batch dot product
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] c
+ * @param[in] n
+ */
+inline void dot_batch(ConstColumns a, ConstColumns b, int64_t *c,
+                      std::size_t n) {
+  kernels().dot(a, b, c, n);
+}
+
+/**
+ * @brief Batch dot product with a fixed right operand
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] c
+ * @param[in] n
+ */
+inline void dot_batch(ConstColumns a, const Triple &b, int64_t *c,
+                      std::size_t n) {
+  kernels().dot1(a, b, c, n);
+}
+
+/**
+ * @brief Batch Plucker operation
+ *
+ * @param[in] ld
+ * @param[in] p
+ * @param[in] mu
+ * @param[in] q
+ * @param[out] r
+ * @param[in] n
+ */
+inline void plckr_batch(const int64_t *ld, ConstColumns p, const int64_t *mu,
+                        ConstColumns q, Columns r, std::size_t n) {
+  kernels().plckr(ld, p, mu, q, r, n);
+}
+
+/**
+ * @brief Batch 3x3 determinant (triple product)
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @param[out] d
+ * @param[in] n
+ */
+inline void det3_batch(ConstColumns a, ConstColumns b, ConstColumns c,
+                       int64_t *d, std::size_t n) {
+  kernels().det3(a, b, c, d, n);
+}
+
+/**
+ * @brief Batch signs of dot products with a fixed right operand, packed
+ *        into bitmasks
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] pos ceil(n/64) words; bit i set iff a_i . b > 0
+ * @param[out] neg ceil(n/64) words; bit i set iff a_i . b < 0
+ * @param[in] n
+ */
+inline void sign_batch(ConstColumns a, const Triple &b, uint64_t *pos,
+                       uint64_t *neg, std::size_t n) {
+  kernels().sign1(a, b, pos, neg, n);
+}
+
+/**
+ * @brief Batch 3x3 matrix-vector product
+ *
+ * @param[in] a
+ * @param[in] m
+ * @param[out] c (may alias a)
+ * @param[in] n
+ */
+inline void xform_batch(ConstColumns a, const Matrix &m, Columns c,
+                        std::size_t n) {
+  kernels().xform(a, m, c, n);
+}
+
+} // namespace fun::simd
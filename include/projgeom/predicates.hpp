@@ -0,0 +1,320 @@
+#pragma once
+
+/** @file include/projgeom/predicates.hpp
+ *  Triple-product (det3) and orientation predicates.
+ *
+ *  det[p; q; r] vanishes iff the points p, q, r are collinear (or the lines
+ *  concurrent), and its sign is the orientation of the triple. orient() is
+ *  exact for int64_t (__int128, or int64 where the compiler has no
+ *  __int128, with overflow checks; BigInt beyond) and for double
+ *  (floating-point filter, exact BigInt fallback).
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "bigint.hpp"
+#include "int128.hpp"
+#include "pg_simd.hpp"
+
+namespace fun {
+
+/**
+ * @brief 3x3 determinant det[a; b; c] = a . (b x c)
+ *
+ * @tparam T scalar
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @return T
+ */
+template <typename T>
+constexpr auto det3(const std::array<T, 3> &a, const std::array<T, 3> &b,
+                    const std::array<T, 3> &c) -> T {
+  return a[0] * (b[1] * c[2] - b[2] * c[1]) +
+         a[1] * (b[2] * c[0] - b[0] * c[2]) +
+         a[2] * (b[0] * c[1] - b[1] * c[0]);
+}
+
+namespace detail {
+
+template <typename T> constexpr auto sign_of(const T &x) -> int {
+  return (T(0) < x) - (x < T(0));
+}
+
+inline auto det3_big(const std::array<BigInt, 3> &a,
+                     const std::array<BigInt, 3> &b,
+                     const std::array<BigInt, 3> &c) -> int {
+  return det3(a, b, c).sign();
+}
+
+// x * 2^k for k >= 0
+inline auto shl(BigInt x, int k) -> BigInt {
+  for (; k >= 62; k -= 62) {
+    x *= BigInt{int64_t(1) << 62};
+  }
+  return x * BigInt{int64_t(1) << k};
+}
+
+} // namespace detail
+
+/**
+ * @brief Orientation of three int64 triples: the sign of det[a; b; c]
+ *
+ * Exact. The minors and products are taken in __int128 with overflow
+ * checks; only when one of those overflows (coordinates beyond about
+ * 2^42) is the determinant redone in BigInt. Without __int128 the checked
+ * arithmetic is done in int64, which falls back to BigInt beyond about
+ * 2^20.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @return int -1, 0 or 1
+ */
+inline auto orient(const std::array<int64_t, 3> &a,
+                   const std::array<int64_t, 3> &b,
+                   const std::array<int64_t, 3> &c) -> int {
+#if PROJGEOM_HAS_INT128
+  using W = __int128;
+  const auto minor = [](W p, W q, W r, W s, W *res) {
+    return __builtin_sub_overflow(p * q, r * s, res);
+  };
+  const auto mul = [](W p, W q, W *res) {
+    return __builtin_mul_overflow(p, q, res);
+  };
+  const auto add = [](W p, W q, W *res) {
+    return __builtin_add_overflow(p, q, res);
+  };
+#else
+  using W = int64_t;
+  const auto minor = [](W p, W q, W r, W s, W *res) {
+    W pq, rs;
+    return detail::mul_overflow(p, q, &pq) || detail::mul_overflow(r, s, &rs) ||
+           detail::sub_overflow(pq, rs, res);
+  };
+  const auto mul = detail::mul_overflow;
+  const auto add = detail::add_overflow;
+#endif
+  W m0, m1, m2, t0, t1, t2, sum;
+  const bool overflow = minor(b[1], c[2], b[2], c[1], &m0) ||
+                        minor(b[2], c[0], b[0], c[2], &m1) ||
+                        minor(b[0], c[1], b[1], c[0], &m2) ||
+                        mul(a[0], m0, &t0) || mul(a[1], m1, &t1) ||
+                        mul(a[2], m2, &t2) || add(t0, t1, &sum) ||
+                        add(sum, t2, &sum);
+  if (!overflow) [[likely]] {
+    return detail::sign_of(sum);
+  }
+  const auto big = [](const std::array<int64_t, 3> &x) {
+    return std::array<BigInt, 3>{BigInt{x[0]}, BigInt{x[1]}, BigInt{x[2]}};
+  };
+  return detail::det3_big(big(a), big(b), big(c));
+}
+
+/**
+ * @brief Sign of the dot product a . b of two int64 triples
+ *
+ * Exact: the products are taken in __int128 (checked int64 without it)
+ * and only an overflowing sum or product is redone in BigInt.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @return int -1, 0 or 1
+ */
+inline auto dot_sign(const std::array<int64_t, 3> &a,
+                     const std::array<int64_t, 3> &b) -> int {
+#if PROJGEOM_HAS_INT128
+  using W = __int128;
+  const auto t0 = W(a[0]) * b[0], t1 = W(a[1]) * b[1], t2 = W(a[2]) * b[2];
+  W sum;
+  if (!__builtin_add_overflow(t0, t1, &sum) &&
+      !__builtin_add_overflow(sum, t2, &sum)) [[likely]] {
+    return detail::sign_of(sum);
+  }
+  return (BigInt{t0} + BigInt{t1} + BigInt{t2}).sign();
+#else
+  int64_t t0, t1, t2, sum;
+  if (!detail::mul_overflow(a[0], b[0], &t0) &&
+      !detail::mul_overflow(a[1], b[1], &t1) &&
+      !detail::mul_overflow(a[2], b[2], &t2) &&
+      !detail::add_overflow(t0, t1, &sum) &&
+      !detail::add_overflow(sum, t2, &sum)) [[likely]] {
+    return detail::sign_of(sum);
+  }
+  return (BigInt{a[0]} * BigInt{b[0]} + BigInt{a[1]} * BigInt{b[1]} +
+          BigInt{a[2]} * BigInt{b[2]})
+      .sign();
+#endif
+}
+
+/**
+ * @brief Sign of the dot product a . b for other ordered scalars
+ *
+ * @tparam T
+ * @param[in] a
+ * @param[in] b
+ * @return int -1, 0 or 1
+ */
+template <typename T>
+constexpr auto dot_sign(const std::array<T, 3> &a, const std::array<T, 3> &b)
+    -> int {
+  return detail::sign_of(a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+/**
+ * @brief Orientation of three double triples: the sign of det[a; b; c]
+ *
+ * Adaptive: the determinant is first evaluated in floating point together
+ * with a bound on its rounding error (the coefficient of Shewchuk's
+ * orient3d filter); only when |det| is within that bound are the inputs
+ * converted exactly to integers (mantissa times a common power of two) and
+ * the determinant redone in BigInt. Inputs must be finite.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @return int -1, 0 or 1
+ */
+inline auto orient(const std::array<double, 3> &a,
+                   const std::array<double, 3> &b,
+                   const std::array<double, 3> &c) -> int {
+  constexpr double u = std::numeric_limits<double>::epsilon() / 2;
+  constexpr double errbound = (7.0 + 56.0 * u) * u;
+  const auto p0 = b[1] * c[2], q0 = b[2] * c[1];
+  const auto p1 = b[2] * c[0], q1 = b[0] * c[2];
+  const auto p2 = b[0] * c[1], q2 = b[1] * c[0];
+  const auto det = a[0] * (p0 - q0) + a[1] * (p1 - q1) + a[2] * (p2 - q2);
+  const auto perm = std::abs(a[0]) * (std::abs(p0) + std::abs(q0)) +
+                    std::abs(a[1]) * (std::abs(p1) + std::abs(q1)) +
+                    std::abs(a[2]) * (std::abs(p2) + std::abs(q2));
+  if (std::abs(det) > errbound * perm) [[likely]] {
+    return (det > 0) - (det < 0);
+  }
+
+  // exact: x = m 2^e with |m| < 2^53; scale all entries by 2^-emin
+  const auto entries =
+      std::array<const std::array<double, 3> *, 3>{&a, &b, &c};
+  int emin = std::numeric_limits<int>::max();
+  for (const auto *row : entries) {
+    for (const auto x : *row) {
+      if (x != 0.0) {
+        int e;
+        std::frexp(x, &e);
+        emin = std::min(emin, e - 53);
+      }
+    }
+  }
+  if (emin == std::numeric_limits<int>::max()) {
+    return 0; // all zero
+  }
+  auto rows = std::array<std::array<BigInt, 3>, 3>{};
+  for (std::size_t i = 0; i != 3; ++i) {
+    for (std::size_t k = 0; k != 3; ++k) {
+      const auto x = (*entries[i])[k];
+      if (x == 0.0) {
+        continue;
+      }
+      int e;
+      const auto m = int64_t(std::ldexp(std::frexp(x, &e), 53));
+      rows[i][k] = detail::shl(BigInt{m}, e - 53 - emin);
+    }
+  }
+  return detail::det3_big(rows[0], rows[1], rows[2]);
+}
+
+/**
+ * @brief Orientation for other ordered scalars: the sign of det3
+ *
+ * @tparam T
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @return int -1, 0 or 1
+ */
+template <typename T>
+auto orient(const std::array<T, 3> &a, const std::array<T, 3> &b,
+            const std::array<T, 3> &c) -> int {
+  return detail::sign_of(det3(a, b, c));
+}
+
+/**
+ * @brief Whether det[a; b; c] vanishes
+ *
+ * Uses the exact orient() for int64_t and double, and det3 == 0 otherwise
+ * (scalars that need not be ordered, e.g. ModInt) and during constant
+ * evaluation.
+ *
+ * @tparam T
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @return true
+ * @return false
+ */
+template <typename T>
+constexpr auto det3_is_zero(const std::array<T, 3> &a,
+                            const std::array<T, 3> &b,
+                            const std::array<T, 3> &c) -> bool {
+  if (std::is_constant_evaluated()) {
+    return det3(a, b, c) == T(0); // orient() is not constexpr
+  }
+  if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+    return orient(a, b, c) == 0;
+  } else {
+    return det3(a, b, c) == T(0);
+  }
+}
+
+/**
+ * @brief Batch orientation of int64 triples given as columns
+ *
+ * When every coordinate is below 2^20 in magnitude, det3 fits in int64
+ * (|det| < 6 * 2^60) and the whole batch goes through the SIMD det3
+ * kernel; otherwise each element takes the exact scalar orient().
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[in] c
+ * @param[out] sign -1, 0 or 1 per element
+ * @param[in] n
+ */
+inline void orient_batch(simd::ConstColumns a, simd::ConstColumns b,
+                         simd::ConstColumns c, int8_t *sign, std::size_t n) {
+  constexpr int64_t bound = int64_t(1) << 20;
+  constexpr std::size_t chunk = 256;
+  int64_t det[chunk];
+  for (std::size_t i = 0; i < n; i += chunk) {
+    const auto m = std::min(chunk, n - i);
+    auto small = true;
+    for (const auto &cols : {a, b, c}) {
+      for (std::size_t k = 0; k != 3; ++k) {
+        for (std::size_t j = i; j != i + m; ++j) {
+          small &= cols[k][j] > -bound && cols[k][j] < bound;
+        }
+      }
+    }
+    if (small) {
+      simd::det3_batch({a[0] + i, a[1] + i, a[2] + i},
+                       {b[0] + i, b[1] + i, b[2] + i},
+                       {c[0] + i, c[1] + i, c[2] + i}, det, m);
+      for (std::size_t j = 0; j != m; ++j) {
+        sign[i + j] = int8_t((det[j] > 0) - (det[j] < 0));
+      }
+    } else {
+      using Triple = simd::Triple;
+      for (std::size_t j = i; j != i + m; ++j) {
+        sign[j] = int8_t(orient(Triple{a[0][j], a[1][j], a[2][j]},
+                                Triple{b[0][j], b[1][j], b[2][j]},
+                                Triple{c[0][j], c[1][j], c[2][j]}));
+      }
+    }
+  }
+}
+
+} // namespace fun
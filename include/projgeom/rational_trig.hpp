@@ -0,0 +1,341 @@
+#pragma once
+
+/** @file include/projgeom/rational_trig.hpp
+ *  Rational trigonometry on a Cayley-Klein plane: exact quadrance, spread
+ *  and cross, and blocked all-pairs measure matrices.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck_plane.hpp"
+#include "fractions.hpp"
+#include "int128.hpp"
+#include "parallel.hpp"
+#include "pg_array.hpp"
+
+namespace fun {
+
+/**
+ * @brief Type of an exact measure: a Fraction over integer coordinates,
+ *        or the coordinate type itself when it is a field (e.g. Fraction)
+ */
+template <typename T> struct measure_traits {
+  using type = T;
+  static constexpr auto make(const T &num, const T &den) -> type {
+    return num / den;
+  }
+};
+
+template <Integral T> struct measure_traits<T> {
+  using type = Fraction<T>;
+  static constexpr auto make(const T &num, const T &den) -> type {
+    return {num, den};
+  }
+};
+
+template <typename T> using measure_t = typename measure_traits<T>::type;
+
+namespace detail {
+
+/**
+ * @brief (aa bb - ab^2, aa bb) for int64 products, formed in widest_int
+ *        and divided by their gcd
+ *
+ * The reduced pair must fit in int64 (asserted), which always holds when
+ * |aa|, |bb| and |ab| are below 2^31. Without __int128 the unreduced pair
+ * itself must fit.
+ *
+ * @param[in] aa
+ * @param[in] bb
+ * @param[in] ab
+ * @return std::array<int64_t, 2>
+ */
+inline constexpr auto ck_measure_int64(int64_t aa, int64_t bb, int64_t ab)
+    -> std::array<int64_t, 2> {
+#if PROJGEOM_HAS_INT128
+  const auto den = widest_int(aa) * bb;
+  const auto num = den - widest_int(ab) * ab;
+  auto g = gcd(num, den);
+  if (g == 0) {
+    g = 1;
+  }
+  assert(abs(num / g) <= INT64_MAX && abs(den / g) <= INT64_MAX);
+  return {static_cast<int64_t>(num / g), static_cast<int64_t>(den / g)};
+#else
+  int64_t den = 0;
+  int64_t sq = 0;
+  int64_t num = 0;
+  [[maybe_unused]] const bool overflow = mul_overflow(aa, bb, &den) ||
+                                         mul_overflow(ab, ab, &sq) ||
+                                         sub_overflow(den, sq, &num);
+  assert(!overflow);
+  return {num, den};
+#endif
+}
+
+/**
+ * @brief 1 - B(a, b)^2 / (B(a, a) B(b, b)) with B(a, b) = a . perp(b), as
+ *        a (numerator, denominator) pair
+ *
+ * The pair is unreduced, except for int64 coordinates, whose degree-4
+ * terms are reduced in wider arithmetic by ck_measure_int64.
+ */
+template <class O>
+constexpr auto ck_measure(const O &a, const O &b)
+    -> std::array<typename O::value_type, 2> {
+  const auto aa = a.dot(a.perp());
+  const auto bb = b.dot(b.perp());
+  const auto ab = a.dot(b.perp());
+  if constexpr (std::is_same_v<typename O::value_type, int64_t>) {
+    return ck_measure_int64(aa, bb, ab);
+  } else {
+    const auto den = aa * bb;
+    return {den - ab * ab, den};
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Quadrance between two points
+ *
+ * q(a1, a2) = 1 - (a1 . a2^perp)^2 / ((a1 . a1^perp) (a2 . a2^perp)), i.e.
+ * the squared sine of the distance in elliptic geometry. Neither point may
+ * lie on the absolute conic (a null point).
+ *
+ * @tparam P Point
+ * @tparam L Line
+ * @param[in] a1
+ * @param[in] a2
+ * @return measure_t<typename P::value_type>
+ */
+template <class P, class L = typename P::Dual>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<P, L>
+#endif
+constexpr auto quadrance(const P &a1, const P &a2)
+    -> measure_t<typename P::value_type> {
+  using T = typename P::value_type;
+  const auto [num, den] = detail::ck_measure(a1, a2);
+  assert(den != T(0));
+  return measure_traits<T>::make(num, den);
+}
+
+/**
+ * @brief Spread between two lines: the dual of quadrance
+ *
+ * @tparam L Line
+ * @tparam P Point
+ * @param[in] l1
+ * @param[in] l2
+ * @return measure_t<typename L::value_type>
+ */
+template <class L, class P = typename L::Dual>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<L, P>
+#endif
+constexpr auto spread(const L &l1, const L &l2)
+    -> measure_t<typename L::value_type> {
+  using T = typename L::value_type;
+  const auto [num, den] = detail::ck_measure(l1, l2);
+  assert(den != T(0));
+  return measure_traits<T>::make(num, den);
+}
+
+/**
+ * @brief Cross between two lines: 1 - spread(l1, l2) (named cross_s to
+ *        stay apart from the cross product ::cross)
+ *
+ * @tparam L Line
+ * @tparam P Point
+ * @param[in] l1
+ * @param[in] l2
+ * @return measure_t<typename L::value_type>
+ */
+template <class L, class P = typename L::Dual>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<L, P>
+#endif
+constexpr auto cross_s(const L &l1, const L &l2)
+    -> measure_t<typename L::value_type> {
+  using T = typename L::value_type;
+  const auto [num, den] = detail::ck_measure(l1, l2);
+  assert(den != T(0));
+  return measure_traits<T>::make(den - num, den);
+}
+
+/**
+ * @brief Symmetric n x n matrix of measures, as fractions
+ *
+ * Only the upper triangle is stored, row by row (row i holds j = i..n-1),
+ * i.e. n (n + 1) / 2 numerators and denominators: about 800 MB for 10^4
+ * int64 objects. Entry (i, j) is num[index(i, j)] / den[index(i, j)],
+ * not necessarily reduced; den is zero where an object is null.
+ *
+ * @tparam T scalar
+ */
+template <typename T> struct MeasureMatrix {
+  std::size_t n{};
+  std::vector<T> num;
+  std::vector<T> den;
+
+  /**
+   * @brief Position of entry (i, j) (or (j, i)) in num and den
+   *
+   * @param[in] i
+   * @param[in] j
+   * @return std::size_t
+   */
+  [[nodiscard]] auto index(std::size_t i, std::size_t j) const noexcept
+      -> std::size_t {
+    if (i > j) {
+      std::swap(i, j);
+    }
+    return i * this->n - i * (i - 1) / 2 + (j - i);
+  }
+
+  /**
+   * @brief Entry (i, j), reduced
+   *
+   * @param[in] i
+   * @param[in] j
+   * @return measure_t<T>
+   */
+  [[nodiscard]] auto at(std::size_t i, std::size_t j) const -> measure_t<T> {
+    const auto k = this->index(i, j);
+    return measure_traits<T>::make(this->num[k], this->den[k]);
+  }
+};
+
+namespace detail {
+
+/**
+ * @brief All-pairs ck_measure
+ *
+ * perp(o_j) and the self products B(o_j, o_j) are computed once per object
+ * (n perps instead of n^2), into SoA columns. Each row i of the upper
+ * triangle is then one fused pass over those columns, B(o_i, o_j) =
+ * o_i . perp(o_j) followed by the numerator and denominator, with purely
+ * sequential reads and writes; blocks of rows run in parallel.
+ *
+ * The products are formed in T. For int64 that is exact when every
+ * |B(o_i, o_j)| stays below 2^31, which is checked once through the bound
+ * 3 max|o_i| max|perp(o_j)|; when the bound fails, each entry goes through
+ * ck_measure_int64 instead, exactly as quadrance() and spread() do.
+ */
+template <class O>
+auto ck_measure_matrix(const std::vector<O> &objs, unsigned num_threads,
+                       std::size_t grain)
+    -> MeasureMatrix<typename O::value_type> {
+  using T = typename O::value_type;
+  using D = typename O::Dual;
+  const auto n = objs.size();
+  const auto size = n * (n + 1) / 2;
+  auto res = MeasureMatrix<T>{n, std::vector<T>(size), std::vector<T>(size)};
+
+  auto polars = PgArray<D>(n);
+  auto self = std::vector<T>(n);
+  const auto c = polars.columns();
+  for (std::size_t j = 0; j != n; ++j) {
+    const auto pj = objs[j].perp();
+    for (std::size_t k = 0; k != 3; ++k) {
+      c[k][j] = pj.coord[k];
+    }
+    self[j] = objs[j].dot(pj);
+  }
+  auto wide = false;
+  if constexpr (std::is_same_v<T, int64_t>) {
+    int64_t mo = 0;
+    int64_t mp = 0;
+    for (std::size_t j = 0; j != n; ++j) {
+      for (std::size_t k = 0; k != 3; ++k) {
+        mo = std::max(mo, abs(objs[j].coord[k]));
+        mp = std::max(mp, abs(c[k][j]));
+      }
+    }
+    constexpr auto limit = (int64_t(1) << 31) - 1;
+    wide = mo != 0 && mp > limit / 3 / mo;
+  }
+
+  parallel_for(
+      n,
+      [&](std::size_t begin, std::size_t end) {
+        const T *c0 = c[0];
+        const T *c1 = c[1];
+        const T *c2 = c[2];
+        const T *s = self.data();
+        for (auto i = begin; i != end; ++i) {
+          const auto [x, y, z] = objs[i].coord;
+          const auto si = self[i];
+          T *num = res.num.data() + res.index(i, i);
+          T *den = res.den.data() + res.index(i, i);
+          if constexpr (std::is_same_v<T, int64_t>) {
+            if (wide) {
+              for (auto j = i; j != n; ++j) {
+                const auto ab = c0[j] * x + c1[j] * y + c2[j] * z;
+                const auto [nm, dn] = ck_measure_int64(si, s[j], ab);
+                num[j - i] = nm;
+                den[j - i] = dn;
+              }
+              continue;
+            }
+          }
+          for (auto j = i; j != n; ++j) {
+            const auto ab = c0[j] * x + c1[j] * y + c2[j] * z;
+            den[j - i] = si * s[j];
+            num[j - i] = den[j - i] - ab * ab;
+          }
+        }
+      },
+      grain, num_threads);
+  return res;
+}
+
+} // namespace detail
+
+/**
+ * @brief Quadrances between all pairs of points
+ *
+ * @tparam P Point
+ * @param[in] pts
+ * @param[in] num_threads (0: default_concurrency())
+ * @param[in] grain rows per parallel chunk (0: about 8 chunks per thread)
+ * @return MeasureMatrix<typename P::value_type>
+ */
+template <class P>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<P, typename P::Dual>
+#endif
+auto quadrance_matrix(const std::vector<P> &pts, unsigned num_threads = 0,
+                      std::size_t grain = 0)
+    -> MeasureMatrix<typename P::value_type> {
+  return detail::ck_measure_matrix(pts, num_threads, grain);
+}
+
+/**
+ * @brief Spreads between all pairs of lines
+ *
+ * @tparam L Line
+ * @param[in] lns
+ * @param[in] num_threads (0: default_concurrency())
+ * @param[in] grain rows per parallel chunk (0: about 8 chunks per thread)
+ * @return MeasureMatrix<typename L::value_type>
+ */
+template <class L>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<L, typename L::Dual>
+#endif
+auto spread_matrix(const std::vector<L> &lns, unsigned num_threads = 0,
+                   std::size_t grain = 0)
+    -> MeasureMatrix<typename L::value_type> {
+  return detail::ck_measure_matrix(lns, num_threads, grain);
+}
+
+} // namespace fun
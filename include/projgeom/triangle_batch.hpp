@@ -0,0 +1,337 @@
+#pragma once
+
+/** @file include/projgeom/triangle_batch.hpp
+ *  Sides, altitudes, orthocenters and orthic triangles of many triangles
+ *  at once, over structure-of-arrays triangle batches.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "ck_plane.hpp"
+#include "parallel.hpp"
+#include "pg_array.hpp"
+#include "pg_simd.hpp"
+
+namespace fun {
+
+/**
+ * @brief Triangles stored as three vertex columns: triangle i is
+ *        (vertices[0][i], vertices[1][i], vertices[2][i])
+ *
+ * @tparam P Point
+ */
+template <class P> struct TriangleArray {
+  std::array<PgArray<P>, 3> vertices;
+
+  /**
+   * @brief Construct an empty Triangle Array object
+   *
+   */
+  TriangleArray() = default;
+
+  /**
+   * @brief Construct a new Triangle Array object from a list of triangles
+   *
+   * @param[in] tris
+   */
+  explicit TriangleArray(const std::vector<std::array<P, 3>> &tris)
+      : vertices{PgArray<P>(tris.size()), PgArray<P>(tris.size()),
+                 PgArray<P>(tris.size())} {
+    for (std::size_t i = 0; i != tris.size(); ++i) {
+      for (std::size_t k = 0; k != 3; ++k) {
+        this->vertices[k].set(i, tris[i][k]);
+      }
+    }
+  }
+
+  /**
+   * @brief Number of triangles
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return this->vertices[0].size();
+  }
+
+  /**
+   * @brief Append a triangle
+   *
+   * @param[in] tri
+   */
+  void push_back(const std::array<P, 3> &tri) {
+    for (std::size_t k = 0; k != 3; ++k) {
+      this->vertices[k].push_back(tri[k]);
+    }
+  }
+
+  /**
+   * @brief Materialize the i-th triangle
+   *
+   * @param[in] i
+   * @return std::array<P, 3>
+   */
+  auto operator[](std::size_t i) const -> std::array<P, 3> {
+    return {this->vertices[0][i], this->vertices[1][i], this->vertices[2][i]};
+  }
+};
+
+/**
+ * @brief Members of TriangleCenters to compute (combine with |)
+ */
+enum class TriangleOutput : unsigned {
+  Sides = 1U << 0,
+  Poles = 1U << 1,
+  Altitudes = 1U << 2,
+  Orthocenter = 1U << 3,
+  Orthic = 1U << 4,
+  All = (1U << 5) - 1
+};
+
+constexpr auto operator|(TriangleOutput a, TriangleOutput b)
+    -> TriangleOutput {
+  return TriangleOutput(unsigned(a) | unsigned(b));
+}
+
+/**
+ * @brief Whether `set` includes the outputs of `x`
+ *
+ * @param[in] set
+ * @param[in] x
+ * @return true
+ * @return false
+ */
+constexpr auto has_output(TriangleOutput set, TriangleOutput x) -> bool {
+  return (unsigned(set) & unsigned(x)) != 0;
+}
+
+/**
+ * @brief Triangle centers of a TriangleArray, one entry per triangle
+ *
+ * Coordinates agree exactly with the scalar functions: sides with
+ * tri_dual, altitudes with tri_altitude, orthocenter with orthocenter.
+ * Members that were not requested from triangle_centers() are left empty.
+ *
+ * @tparam P Point
+ */
+template <class P> struct TriangleCenters {
+  using L = typename P::Dual;
+
+  std::array<PgArray<L>, 3> sides;     //!< a2 a3, a1 a3, a1 a2
+  std::array<PgArray<P>, 3> poles;     //!< sides[k].perp()
+  std::array<PgArray<L>, 3> altitudes; //!< through a_k, perpendicular to
+                                       //!< sides[k]
+  PgArray<P> orthocenter;
+  std::array<PgArray<P>, 3> orthic; //!< feet of the altitudes
+};
+
+namespace detail {
+
+template <typename T>
+auto tri_cols(std::array<T *, 3> c, std::size_t lo) -> std::array<T *, 3> {
+  return {c[0] + lo, c[1] + lo, c[2] + lo};
+}
+
+// c[0, n) = a x b, column-wise
+template <typename T, class A, class B>
+void tri_cross(const A &a, const B &b, const std::array<T *, 3> &c,
+               std::size_t n) {
+  if constexpr (std::is_same_v<T, int64_t>) {
+    simd::cross_batch(simd::ConstColumns{a[0], a[1], a[2]},
+                      simd::ConstColumns{b[0], b[1], b[2]}, c, n);
+  } else {
+    for (std::size_t i = 0; i != n; ++i) {
+      c[0][i] = a[1][i] * b[2][i] - a[2][i] * b[1][i];
+      c[1][i] = a[2][i] * b[0][i] - a[0][i] * b[2][i];
+      c[2][i] = a[0][i] * b[1][i] - a[1][i] * b[0][i];
+    }
+  }
+}
+
+// p[0, n) = perp(s), column-wise; the columns never overlap, and saying
+// so lets the loop vectorize (there are too many pairs to check at run time)
+template <class L, typename T>
+void tri_perp(const T *__restrict s0, const T *__restrict s1,
+              const T *__restrict s2, T *__restrict p0, T *__restrict p1,
+              T *__restrict p2, std::size_t n) {
+  for (std::size_t i = 0; i != n; ++i) {
+    const auto q = L{{s0[i], s1[i], s2[i]}}.perp();
+    p0[i] = q.coord[0];
+    p1[i] = q.coord[1];
+    p2[i] = q.coord[2];
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Selected sides, poles, altitudes, orthocenters and orthic
+ *        triangles of a batch of triangles, into preallocated arrays
+ *
+ * Each stage reuses the previous ones instead of recomputing them per
+ * center: the sides are computed once, their poles once, and the
+ * altitudes, orthocenter and feet are all meets/joins of those. Triangles
+ * are processed in parallel chunks, each chunk in blocks whose
+ * intermediates live in chunk-local scratch columns small enough for L1/L2;
+ * only the requested members of res are written, each column once. Every
+ * join and meet is a SIMD cross batch for int64 coordinates, and perp is
+ * applied column-wise (for CKGeometry types it is constant-folded and
+ * vectorizes). The orthocenter alone needs only two of the three sides
+ * and altitudes. The requested arrays of res are resized to tris.size()
+ * and the others cleared, so reusing res across calls avoids reallocating
+ * (and page-faulting) them every time.
+ *
+ * @tparam P Point
+ * @param[in] tris
+ * @param[out] res
+ * @param[in] out members of res to compute
+ * @param[in] num_threads (0: default_concurrency())
+ * @param[in] grain triangles per parallel chunk (0: about 8 chunks per
+ *            thread)
+ */
+template <class P, class L = typename P::Dual>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<P, L>
+#endif
+void triangle_centers(const TriangleArray<P> &tris, TriangleCenters<P> &res,
+                      TriangleOutput out, unsigned num_threads = 0,
+                      std::size_t grain = 0) {
+  using T = typename P::value_type;
+  using TO = TriangleOutput;
+  constexpr std::size_t block = 64;
+  const auto n = tris.size();
+  const auto size = [n](bool wanted) { return wanted ? n : 0; };
+  for (std::size_t k = 0; k != 3; ++k) {
+    res.sides[k].resize(size(has_output(out, TO::Sides)));
+    res.poles[k].resize(size(has_output(out, TO::Poles)));
+    res.altitudes[k].resize(size(has_output(out, TO::Altitudes)));
+    res.orthic[k].resize(size(has_output(out, TO::Orthic)));
+  }
+  res.orthocenter.resize(size(has_output(out, TO::Orthocenter)));
+  if (!has_output(out, TO::All)) {
+    return;
+  }
+  // the orthocenter alone needs sides 0 and 1 only
+  const std::size_t nk =
+      has_output(out, TO::Sides | TO::Poles | TO::Altitudes | TO::Orthic) ? 3
+                                                                          : 2;
+
+  parallel_for(
+      n,
+      [&](std::size_t begin, std::size_t end) {
+        // scratch: three sides, one pole, three altitudes (uninitialized);
+        // the padding keeps the columns from being 4 KiB apart, which
+        // would alias their loads and stores in the cache
+        const auto len = std::min(end - begin, block) + 8;
+        const auto scratch = std::make_unique_for_overwrite<T[]>(7 * 3 * len);
+        const auto buf = [&](std::size_t i) -> std::array<T *, 3> {
+          auto *base = scratch.get() + i * 3 * len;
+          return {base, base + len, base + 2 * len};
+        };
+        const auto pick = [&](auto &arr, TO x, std::size_t i,
+                              std::size_t lo) -> std::array<T *, 3> {
+          return has_output(out, x) ? detail::tri_cols(arr.columns(), lo)
+                                    : buf(i);
+        };
+        for (auto lo = begin; lo < end; lo += block) {
+          const auto m = std::min(end - lo, block);
+          auto alt = std::array<std::array<T *, 3>, 3>{};
+          for (std::size_t k = 0; k != nk; ++k) {
+            const auto vertex = [&](std::size_t i) {
+              return detail::tri_cols(tris.vertices[i].columns(), lo);
+            };
+            // a2 a3, a1 a3, a1 a2, as in tri_dual
+            const auto side = pick(res.sides[k], TO::Sides, k, lo);
+            detail::tri_cross(vertex(k == 0 ? 1 : 0), vertex(k == 2 ? 1 : 2),
+                              side, m);
+            const auto pole = pick(res.poles[k], TO::Poles, 3, lo);
+            detail::tri_perp<L>(side[0], side[1], side[2], pole[0], pole[1],
+                                pole[2], m);
+            alt[k] = pick(res.altitudes[k], TO::Altitudes, 4 + k, lo);
+            detail::tri_cross(pole, vertex(k), alt[k], m);
+            if (has_output(out, TO::Orthic)) {
+              detail::tri_cross(alt[k], side,
+                                detail::tri_cols(res.orthic[k].columns(), lo),
+                                m);
+            }
+          }
+          // orthocenter() meets t1 with the altitude on a3 a1 = -sides[1]
+          if (has_output(out, TO::Orthocenter)) {
+            detail::tri_cross(
+                alt[1], alt[0],
+                detail::tri_cols(res.orthocenter.columns(), lo), m);
+          }
+        }
+      },
+      grain, num_threads);
+}
+
+/**
+ * @brief Sides, poles, altitudes, orthocenters and orthic triangles of a
+ *        batch of triangles, into preallocated arrays
+ *
+ * @tparam P Point
+ * @param[in] tris
+ * @param[out] res
+ * @param[in] num_threads (0: default_concurrency())
+ * @param[in] grain triangles per parallel chunk (0: about 8 chunks per
+ *            thread)
+ */
+template <class P, class L = typename P::Dual>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<P, L>
+#endif
+void triangle_centers(const TriangleArray<P> &tris, TriangleCenters<P> &res,
+                      unsigned num_threads = 0, std::size_t grain = 0) {
+  triangle_centers(tris, res, TriangleOutput::All, num_threads, grain);
+}
+
+/**
+ * @brief Selected triangle centers of a batch of triangles
+ *
+ * @tparam P Point
+ * @param[in] tris
+ * @param[in] out members to compute
+ * @param[in] num_threads (0: default_concurrency())
+ * @param[in] grain triangles per parallel chunk (0: about 8 chunks per
+ *            thread)
+ * @return TriangleCenters<P>
+ */
+template <class P, class L = typename P::Dual>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<P, L>
+#endif
+auto triangle_centers(const TriangleArray<P> &tris, TriangleOutput out,
+                      unsigned num_threads = 0, std::size_t grain = 0)
+    -> TriangleCenters<P> {
+  auto res = TriangleCenters<P>{};
+  triangle_centers(tris, res, out, num_threads, grain);
+  return res;
+}
+
+/**
+ * @brief Sides, poles, altitudes, orthocenters and orthic triangles of a
+ *        batch of triangles
+ *
+ * @tparam P Point
+ * @param[in] tris
+ * @param[in] num_threads (0: default_concurrency())
+ * @param[in] grain triangles per parallel chunk (0: about 8 chunks per
+ *            thread)
+ * @return TriangleCenters<P>
+ */
+template <class P, class L = typename P::Dual>
+#if __cpp_concepts >= 201907L
+  requires CKPlanePrimDual<P, L>
+#endif
+auto triangle_centers(const TriangleArray<P> &tris, unsigned num_threads = 0,
+                      std::size_t grain = 0) -> TriangleCenters<P> {
+  return triangle_centers(tris, TriangleOutput::All, num_threads, grain);
+}
+
+} // namespace fun
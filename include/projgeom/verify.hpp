@@ -0,0 +1,267 @@
+#pragma once
+
+/** @file include/projgeom/verify.hpp
+ *  Randomized, multi-threaded verification of the theorem checks in
+ *  pg_plane.hpp, with parallel shrinking of counterexamples.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "int128.hpp"
+#include "parallel.hpp"
+#include "pg_plane.hpp"
+
+namespace fun {
+
+/**
+ * @brief Pappus's theorem on two lines
+ *
+ * A configuration holds four points a, b, d, e and four weights; the
+ * remaining points are c = w0 a + w1 b and f = w2 d + w3 e.
+ *
+ * @tparam P Point
+ */
+template <class P> struct PappusTheorem {
+  using T = typename P::value_type;
+  static constexpr std::size_t size = 16;
+  using Config = std::array<T, size>;
+  static constexpr const char *name = "pappus";
+
+  static auto points(const Config &c) -> std::array<P, 6> {
+    const auto a = P({c[0], c[1], c[2]});
+    const auto b = P({c[3], c[4], c[5]});
+    const auto d = P({c[6], c[7], c[8]});
+    const auto e = P({c[9], c[10], c[11]});
+    return {a, b, P::plucker(c[12], a, c[13], b),
+            d, e, P::plucker(c[14], d, c[15], e)};
+  }
+
+  static auto valid(const Config &c) -> bool {
+    const auto [a, b, cc, d, e, f] = points(c);
+    return a != b && d != e && c[12] != T(0) && c[13] != T(0) &&
+           c[14] != T(0) && c[15] != T(0);
+  }
+
+  static auto check(const Config &c) -> bool {
+    const auto [a, b, cc, d, e, f] = points(c);
+    return check_pappus<P>({a, b, cc}, {d, e, f});
+  }
+};
+
+/**
+ * @brief Desargues's theorem on two triangles
+ *
+ * @tparam P Point
+ */
+template <class P> struct DesargueTheorem {
+  using T = typename P::value_type;
+  static constexpr std::size_t size = 18;
+  using Config = std::array<T, size>;
+  static constexpr const char *name = "desargue";
+
+  static auto triangle(const Config &c, std::size_t k) -> std::array<P, 3> {
+    return {P({c[k], c[k + 1], c[k + 2]}), P({c[k + 3], c[k + 4], c[k + 5]}),
+            P({c[k + 6], c[k + 7], c[k + 8]})};
+  }
+
+  static auto valid(const Config &c) -> bool {
+    const auto [a1, a2, a3] = triangle(c, 0);
+    const auto [b1, b2, b3] = triangle(c, 9);
+    return !coincident(a1, a2, a3) && !coincident(b1, b2, b3);
+  }
+
+  static auto check(const Config &c) -> bool {
+    return check_desargue(triangle(c, 0), triangle(c, 9));
+  }
+};
+
+/**
+ * @brief Projective plane axioms (check_axiom and check_axiom2)
+ *
+ * @tparam P Point
+ */
+template <class P> struct AxiomTheorem {
+  using T = typename P::value_type;
+  using L = typename P::Dual;
+  static constexpr std::size_t size = 11;
+  using Config = std::array<T, size>;
+  static constexpr const char *name = "axiom";
+
+  static auto valid(const Config &c) -> bool {
+    return P({c[0], c[1], c[2]}) != P({c[3], c[4], c[5]});
+  }
+
+  static auto check(const Config &c) -> bool {
+    const auto p = P({c[0], c[1], c[2]});
+    const auto q = P({c[3], c[4], c[5]});
+    const auto l = L({c[6], c[7], c[8]});
+    return check_axiom(p, q, l) && check_axiom2(p, q, l, c[9], c[10]);
+  }
+};
+
+/**
+ * @brief Outcome of verify()
+ *
+ * @tparam Thm theorem
+ */
+template <class Thm> struct VerifyReport {
+  std::size_t checked{0};  //!< configurations checked
+  std::size_t skipped{0};  //!< degenerate configurations
+  std::size_t failures{0}; //!< configurations that failed the check
+  double seconds{0.0};
+  /** First failing configuration (by index), already shrunk */
+  std::optional<typename Thm::Config> counterexample;
+
+  [[nodiscard]] auto configs_per_second() const -> double {
+    return this->seconds > 0.0 ? double(this->checked) / this->seconds : 0.0;
+  }
+};
+
+/**
+ * @brief Shrink a failing configuration
+ *
+ * Each round builds every one-step simplification (an entry set to zero,
+ * halved, or moved one towards zero), checks all of them in parallel and
+ * keeps the first that is still valid and still fails. Stops when no
+ * candidate fails.
+ *
+ * @tparam Thm theorem
+ * @param[in] config failing configuration
+ * @param[in] num_threads (0: default_concurrency())
+ * @return Thm::Config
+ */
+template <class Thm>
+auto shrink(typename Thm::Config config, unsigned num_threads = 0) ->
+    typename Thm::Config {
+  using T = typename Thm::T;
+  using Config = typename Thm::Config;
+  while (true) {
+    std::vector<Config> candidates;
+    for (std::size_t k = 0; k != Thm::size; ++k) {
+      const auto v = config[k];
+      if (v == T(0)) {
+        continue;
+      }
+      for (const auto w : {T(0), T(v / T(2)), v < T(0) ? v + T(1) : v - T(1)}) {
+        if (w != v) {
+          auto next = config;
+          next[k] = w;
+          candidates.push_back(next);
+        }
+      }
+    }
+    std::mutex mutex;
+    auto best = candidates.size();
+    parallel_for(
+        candidates.size(),
+        [&](std::size_t begin, std::size_t end) {
+          for (auto i = begin; i != end; ++i) {
+            if (Thm::valid(candidates[i]) && !Thm::check(candidates[i])) {
+              std::lock_guard<std::mutex> lock(mutex);
+              best = std::min(best, i);
+              return;
+            }
+          }
+        },
+        1, num_threads);
+    if (best == candidates.size()) {
+      return config;
+    }
+    config = candidates[best];
+  }
+}
+
+namespace detail {
+
+/**
+ * @brief Entry `counter` of the splitmix64 sequence started at `seed`
+ *
+ * @param[in] seed
+ * @param[in] counter
+ * @return uint64_t
+ */
+constexpr auto splitmix64(uint64_t seed, uint64_t counter) -> uint64_t {
+  auto z = seed + 0x9e3779b97f4a7c15ULL * (counter + 1);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+} // namespace detail
+
+/**
+ * @brief Check a theorem on random configurations across all cores
+ *
+ * Entry k of configuration i is a pure function of (seed, i, k), the
+ * splitmix64 output at counter i * size + k, so the result does not depend
+ * on the number of threads or the scheduling, and no generator is seeded
+ * per configuration.
+ *
+ * @tparam Thm theorem, e.g. PappusTheorem<EllPoint>
+ * @param[in] count number of configurations
+ * @param[in] seed
+ * @param[in] bound coordinates are drawn from [-bound, bound]
+ * @param[in] num_threads (0: default_concurrency())
+ * @return VerifyReport<Thm>
+ */
+template <class Thm>
+auto verify(std::size_t count, uint64_t seed = 2023, int64_t bound = 1 << 6,
+            unsigned num_threads = 0) -> VerifyReport<Thm> {
+  using T = typename Thm::T;
+  using Config = typename Thm::Config;
+
+  std::mutex mutex;
+  auto report = VerifyReport<Thm>{};
+  auto first_index = std::numeric_limits<std::size_t>::max();
+  auto first = Config{};
+
+  const auto start = std::chrono::steady_clock::now();
+  parallel_for(
+      count,
+      [&](std::size_t begin, std::size_t end) {
+        std::size_t skipped = 0;
+        std::size_t failures = 0;
+        // [-bound, bound] by multiply-shift (bias at most range / 2^64)
+        const auto range = 2 * uint64_t(bound) + 1;
+        for (auto i = begin; i != end; ++i) {
+          auto config = Config{};
+          for (std::size_t k = 0; k != Thm::size; ++k) {
+            const auto z = detail::splitmix64(seed, i * Thm::size + k);
+            config[k] = T(int64_t(detail::mul_wide(z, range).first) - bound);
+          }
+          if (!Thm::valid(config)) {
+            ++skipped;
+          } else if (!Thm::check(config)) {
+            if (failures++ == 0) {
+              std::lock_guard<std::mutex> lock(mutex);
+              if (i < first_index) {
+                first_index = i;
+                first = config;
+              }
+            }
+          }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        report.skipped += skipped;
+        report.failures += failures;
+        report.checked += end - begin - skipped;
+      },
+      0, num_threads);
+  report.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  if (report.failures != 0) {
+    report.counterexample = shrink<Thm>(first, num_threads);
+  }
+  return report;
+}
+
+} // namespace fun
@@ -0,0 +1,89 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+
+#include <projgeom/adaptive_int.hpp>
+#include <projgeom/pg_object.hpp>
+
+using fun::AdaptiveInt;
+using fun::BigInt;
+
+TEST_CASE("AdaptiveInt widens only on overflow") {
+  const auto a = AdaptiveInt(int64_t(3'000'000'000));
+  const auto b = a * a;
+  CHECK(b.rep() == AdaptiveInt::Rep::Small);
+  const auto c = b * a;
+#if PROJGEOM_HAS_INT128
+  CHECK(c.rep() == AdaptiveInt::Rep::Wide);
+#else
+  CHECK(c.rep() == AdaptiveInt::Rep::Big);
+#endif
+  const auto d = c * c;
+  CHECK(d.rep() == AdaptiveInt::Rep::Big);
+  CHECK(d.to_string() == "729000000000000000000000000000000000000000000000000"
+                         "000000");
+  const auto e = d - d + AdaptiveInt(7);
+  CHECK(e.rep() == AdaptiveInt::Rep::Small);
+  CHECK(e == AdaptiveInt(7));
+  CHECK(-c < c);
+  CHECK(AdaptiveInt(INT64_MAX) + AdaptiveInt(1) > AdaptiveInt(INT64_MAX));
+  CHECK((-c).sign() == -1);
+  CHECK(sizeof(AdaptiveInt) == 3 * sizeof(int64_t));
+
+  auto f = d; // copies and moves keep the BigInt owned exactly once
+  auto g = std::move(f);
+  f = g;
+  g = c;
+  CHECK(f == d);
+  CHECK(g == c);
+}
+
+TEST_CASE("AdaptiveInt nested meet/join is exact") {
+  using Coord = std::array<AdaptiveInt, 3>;
+  using BigCoord = std::array<BigInt, 3>;
+  const int64_t big = int64_t(1) << 40;
+  const std::array<std::array<int64_t, 3>, 4> pts{
+      {{big + 1, -3, 7}, {5, big - 9, -big}, {-big, 11, big + 3},
+       {2, -big, 13}}};
+  auto lift = [](const std::array<int64_t, 3> &p) -> Coord {
+    return {p[0], p[1], p[2]};
+  };
+  auto lift_big = [](const std::array<int64_t, 3> &p) -> BigCoord {
+    return {p[0], p[1], p[2]};
+  };
+  const auto m = ::cross(::cross(lift(pts[0]), lift(pts[1])),
+                         ::cross(lift(pts[2]), lift(pts[3])));
+  const auto m_big = ::cross(::cross(lift_big(pts[0]), lift_big(pts[1])),
+                             ::cross(lift_big(pts[2]), lift_big(pts[3])));
+  for (int k = 0; k != 3; ++k) {
+    CHECK(m[k].to_big() == m_big[k]);
+  }
+  // the meet lies on both joins
+  CHECK(::dot(m, ::cross(lift(pts[0]), lift(pts[1]))) == AdaptiveInt(0));
+}
+
+TEST_CASE("AdaptiveInt keeps the two's complement minimum narrow") {
+  const auto two62 = int64_t(1) << 62;
+  const auto min64 = BigInt(two62) * BigInt(-2);
+  CHECK(min64.fits_int64());
+  CHECK(min64.to_int64() == INT64_MIN);
+  CHECK_FALSE((BigInt(two62) * BigInt(2)).fits_int64());
+  const auto small = AdaptiveInt(min64); // through BigInt
+  CHECK(small.rep() == AdaptiveInt::Rep::Small);
+  CHECK(small == AdaptiveInt(INT64_MIN));
+
+#if PROJGEOM_HAS_INT128
+  const auto min128 = BigInt(two62) * BigInt(two62) * BigInt(-8);
+  CHECK(min128.fits_int128());
+  CHECK(BigInt(min128.to_int128()) == min128);
+  CHECK_FALSE((BigInt(two62) * BigInt(two62) * BigInt(8)).fits_int128());
+  const auto wide = AdaptiveInt(two62) * AdaptiveInt(-two62) * AdaptiveInt(8);
+  const auto big = AdaptiveInt(min128);
+  CHECK(wide.rep() == AdaptiveInt::Rep::Wide);
+  CHECK(big.rep() == AdaptiveInt::Rep::Wide);
+  CHECK(wide == big);
+  CHECK((wide - big).sign() == 0);
+  CHECK((-wide).rep() == AdaptiveInt::Rep::Big);
+#endif
+}
@@ -0,0 +1,104 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <projgeom/arrangement.hpp>
+#include <projgeom/pg_object.hpp>
+
+TEST_CASE("Arrangement of a pencil plus one line") {
+  const auto o = PgPoint({1, 2, 3});
+  auto lns = std::vector<PgLine>{};
+  for (const auto &q : {PgPoint({1, 0, 0}), PgPoint({0, 1, 0}),
+                        PgPoint({0, 0, 1}), PgPoint({1, 1, 1}),
+                        PgPoint({2, -1, 5})}) {
+    lns.push_back(o.circ(q));
+  }
+  lns.push_back(PgLine({1, 1, 1})); // not through o
+  lns.push_back(lns[2]);            // a duplicate
+
+  const auto arr = fun::arrangement(lns, 3, 2);
+  CHECK_EQ(arr.degenerate_pairs, 1);
+  // o, and where the last line crosses each of the 5 pencil lines
+  CHECK_EQ(arr.num_points(), 6);
+  CHECK(arr.points[0] == o);
+  CHECK_EQ(arr.degree(0), 6); // the duplicate passes through o as well
+  for (std::size_t k = 1; k != arr.num_points(); ++k) {
+    CHECK_EQ(arr.degree(k), k == 3 ? 3 : 2);
+    for (const auto l : arr.lines_through(k)) {
+      CHECK(arr.points[k].incident(lns[l]));
+    }
+  }
+}
+
+TEST_CASE("Arrangement matches brute force") {
+  std::mt19937_64 gen{2023};
+  std::uniform_int_distribution<int64_t> dist{-5, 5};
+  auto lns = std::vector<PgLine>{};
+  while (lns.size() != 150) {
+    const auto l = PgLine({dist(gen), dist(gen), dist(gen)});
+    if (l.coord != std::array<int64_t, 3>{}) {
+      lns.push_back(l); // small coordinates: many concurrent triples
+    }
+  }
+
+  // brute force: canonical meet -> set of lines
+  auto want = std::map<std::array<int64_t, 3>, std::set<uint32_t>>{};
+  std::size_t degenerate = 0;
+  for (uint32_t i = 0; i != lns.size(); ++i) {
+    for (uint32_t j = i + 1; j != lns.size(); ++j) {
+      const auto p = lns[i].circ(lns[j]);
+      if (p.coord == std::array<int64_t, 3>{}) {
+        ++degenerate;
+        continue;
+      }
+      auto &s = want[fun::canonicalize(p).coord];
+      s.insert(i);
+      s.insert(j);
+    }
+  }
+
+  for (const unsigned threads : {1U, 4U}) {
+    const auto arr = fun::arrangement(lns, threads, 16);
+    CHECK_EQ(arr.degenerate_pairs, degenerate);
+    REQUIRE(arr.num_points() == want.size());
+    for (std::size_t k = 0; k != arr.num_points(); ++k) {
+      const auto span = arr.lines_through(k);
+      const auto got = std::set<uint32_t>(span.begin(), span.end());
+      CHECK(got == want[arr.points[k].coord]);
+      CHECK_EQ(got.size(), span.size());
+    }
+    // the order is canonical
+    const auto first = fun::canonicalize(lns[0].circ(lns[1]));
+    CHECK(arr.points[0].coord == first.coord);
+  }
+  CHECK(fun::arrangement(lns, 1).lines == fun::arrangement(lns, 4).lines);
+}
+
+#if PROJGEOM_HAS_INT128
+TEST_CASE("Arrangement of lines with coordinates beyond 2^31") {
+  // scaling every line by 2^40 leaves the arrangement unchanged, but the
+  // unreduced meets no longer fit in int64
+  std::mt19937_64 gen{7};
+  std::uniform_int_distribution<int64_t> dist{-5, 5};
+  auto lns = std::vector<PgLine>{};
+  auto big = std::vector<PgLine>{};
+  while (lns.size() != 100) {
+    const auto l = PgLine({dist(gen), dist(gen), dist(gen)});
+    if (l.coord != std::array<int64_t, 3>{}) {
+      lns.push_back(l);
+      const auto s = int64_t(1) << 40;
+      big.push_back(PgLine({s * l.coord[0], s * l.coord[1], s * l.coord[2]}));
+    }
+  }
+  const auto want = fun::arrangement(lns, 1, 16);
+  const auto got = fun::arrangement(big, 4, 16);
+  CHECK_EQ(got.degenerate_pairs, want.degenerate_pairs);
+  CHECK(got.points == want.points);
+  CHECK(got.offsets == want.offsets);
+  CHECK(got.lines == want.lines);
+}
+#endif
@@ -0,0 +1,43 @@
+#include <doctest/doctest.h>
+
+#include <unordered_set>
+
+#include <projgeom/canonical.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/pg_object.hpp>
+
+TEST_CASE("canonical form") {
+  const auto p = fun::canonicalize(PgPoint({-4, 6, -10}));
+  CHECK(p.coord == std::array<int64_t, 3>{2, -3, 5});
+  const auto q = fun::canonicalize(PgPoint({0, -7, 14}));
+  CHECK(q.coord == std::array<int64_t, 3>{0, 1, -2});
+  const auto z = fun::canonicalize(PgPoint({0, 0, 0}));
+  CHECK(z.coord == std::array<int64_t, 3>{0, 0, 0});
+  // (2, 0, 0) x (0, -4, 0) = (0, 0, -8)
+  CHECK(fun::canonical_cross({2, 0, 0}, {0, -4, 0}) ==
+        std::array<int64_t, 3>{0, 0, 1});
+  CHECK(fun::canonical_cross({1, 2, 3}, {-2, -4, -6}) ==
+        std::array<int64_t, 3>{});
+}
+
+TEST_CASE("dedup projectively equal points with std::hash") {
+  std::unordered_set<fun::Canonical<PgPoint>> pts;
+  pts.emplace(PgPoint({1, 2, 3}));
+  pts.emplace(PgPoint({-2, -4, -6}));
+  pts.emplace(PgPoint({3, 6, 9}));
+  pts.emplace(PgPoint({1, 2, 4}));
+  CHECK(pts.size() == 2);
+  CHECK(pts.count(fun::Canonical<PgPoint>(PgPoint({5, 10, 15}))) == 1);
+
+  // meets of lines through a common point collapse to one entry
+  const auto o = HypPoint({2, -1, 3});
+  std::unordered_set<fun::Canonical<HypPoint>> meets;
+  const auto l1 = o.circ(HypPoint({1, 0, 0}));
+  const auto l2 = o.circ(HypPoint({0, 1, 5}));
+  const auto l3 = o.circ(HypPoint({7, 1, -2}));
+  meets.emplace(l1.circ(l2));
+  meets.emplace(l2.circ(l3));
+  meets.emplace(l3.circ(l1));
+  CHECK(meets.size() == 1);
+  CHECK(meets.begin()->get() == o);
+}
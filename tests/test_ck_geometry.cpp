@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <projgeom/ck_geometry.hpp>
+#include <projgeom/ck_plane.hpp>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/myck_object.hpp>
+#include <projgeom/persp_object.hpp>
+
+// a non-diagonal conic: 2x^2 + 2xy + 3y^2 - z^2 + 2yz
+using SkewGeometry = CKGeometry<CKMatrix{{{2, 1, 0}, {1, 3, 1}, {0, 1, -1}}}>;
+using SkewPoint = SkewGeometry::Point<int64_t>;
+
+static_assert(MyCKGeometry::line_polar == ck_diagonal(-1, 2, -1));
+static_assert(HypGeometry::line_polar == ck_diagonal(1, 1, -1));
+static_assert(EllGeometry::line_polar == ck_diagonal(1, 1, 1));
+static_assert(MyCKPoint({1, 2, 3}).perp().coord ==
+              std::array<int64_t, 3>{-2, 2, -6});
+
+TEST_CASE("Generated perp matches the hand-written polarities") {
+  const auto p = std::array<int64_t, 3>{3, -5, 7};
+  CHECK(EllPoint(p).perp().coord == p);
+  CHECK(EllLine(p).perp().coord == p);
+  CHECK(HypPoint(p).perp().coord == std::array<int64_t, 3>{3, -5, -7});
+  CHECK(HypLine(p).perp().coord == std::array<int64_t, 3>{3, -5, -7});
+  CHECK(MyCKPoint(p).perp().coord == std::array<int64_t, 3>{-6, -5, -14});
+  CHECK(MyCKLine(p).perp().coord == std::array<int64_t, 3>{-3, -10, -7});
+  CHECK(PerspLine(p).perp().coord == std::array<int64_t, 3>{3, 2, 2});
+  CHECK(PerspLine(p).perp() ==
+        PerspPoint::plucker(PerspLine(p).dot(I_RE), I_RE,
+                            PerspLine(p).dot(I_IM), I_IM));
+}
+
+template <class P> void check_polarity() {
+  using T = typename P::value_type;
+  const auto a1 = P({T(1), T(3), T(2)});
+  const auto a2 = P({T(-2), T(1), T(-1)});
+  const auto a3 = P({T(2), T(-2), T(1)});
+  // the polarity is an involution, and altitudes are concurrent
+  const auto [t1, t2, t3] = fun::tri_altitude(std::array<P, 3>{a1, a2, a3});
+  CHECK(a1.perp().perp() == a1);
+  CHECK(a1.circ(a2).perp().perp() == a1.circ(a2));
+  CHECK(t3.incident(t1.circ(t2)));
+}
+
+TEST_CASE("CKGeometry with a general symmetric conic") {
+  check_polarity<SkewPoint>();
+  check_polarity<SkewGeometry::Point<fun::Fraction<int64_t>>>();
+#if PROJGEOM_HAS_INT128
+  check_polarity<BasicMyCKPoint<__int128>>();
+#endif
+  // pole and polar are incident exactly on the conic: 2 + 2 + 3 - 1 + 2 != 0
+  CHECK(!SkewPoint({1, 1, 1}).incident(SkewPoint({1, 1, 1}).perp()));
+  CHECK(SkewPoint({0, 1, 3}).incident(SkewPoint({0, 1, 3}).perp())); // 3+6-9
+}
+
+TEST_CASE("Batch perp") {
+  auto pts = std::vector<HypPoint>{};
+  for (int64_t i = 0; i != 19; ++i) {
+    pts.push_back(HypPoint({i, 2 - i, 3 * i + 1}));
+  }
+  const auto arr = PgArray<HypPoint>(pts);
+  const auto lns = fun::perp(arr);
+  const auto back = fun::perp(lns);
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    CHECK(lns[i] == pts[i].perp());
+    CHECK(back[i].coord == pts[i].coord);
+  }
+}
@@ -0,0 +1,93 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/ck_geometry.hpp>
+#include <projgeom/ck_plane.hpp>
+#include <projgeom/ck_runtime.hpp>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/myck_object.hpp>
+
+using SkewGeometry = CKGeometry<CKMatrix{{{2, 1, 0}, {1, 3, 1}, {0, 1, -1}}}>;
+
+// the runtime geometry built from Geom agrees with Geom::Point, one by one
+// and in batches
+template <class Geom> void check_matches_compile_time() {
+  using CP = typename Geom::template Point<int64_t>;
+  using CL = typename Geom::template Line<int64_t>;
+  const auto geom = fun::CKRuntimeGeometry<>(Geom{});
+  std::mt19937_64 gen{7};
+  std::uniform_int_distribution<int64_t> dist{-100, 100};
+  auto pts = std::vector<PgPoint>{};
+  auto lns = std::vector<PgLine>{};
+  for (int i = 0; i != 37; ++i) {
+    pts.push_back(PgPoint({dist(gen), dist(gen), dist(gen)}));
+    lns.push_back(PgLine({dist(gen), dist(gen), dist(gen)}));
+  }
+  const auto polars = geom.perp(PgPointArray(pts));
+  const auto poles = geom.perp(PgLineArray(lns));
+  const auto alts = geom.altitude(PgPointArray(pts), PgLineArray(lns));
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    const auto want_l = CP(pts[i].coord).perp().coord;
+    const auto want_p = CL(lns[i].coord).perp().coord;
+    const auto want_alt =
+        fun::altitude(CP(pts[i].coord), CL(lns[i].coord)).coord;
+    CHECK(geom.perp(pts[i]).coord == want_l);
+    CHECK(polars[i].coord == want_l);
+    CHECK(geom.perp(lns[i]).coord == want_p);
+    CHECK(poles[i].coord == want_p);
+    CHECK(geom.altitude(pts[i], lns[i]).coord == want_alt);
+    CHECK(alts[i].coord == want_alt);
+  }
+}
+
+TEST_CASE("Runtime CK geometry matches the compile-time one") {
+  check_matches_compile_time<EllGeometry>();
+  check_matches_compile_time<HypGeometry>();
+  check_matches_compile_time<MyCKGeometry>();
+  check_matches_compile_time<SkewGeometry>();
+}
+
+TEST_CASE("Runtime CK geometry picks a kernel per matrix shape") {
+  using fun::PolarKind;
+  const auto ell = fun::CKRuntimeGeometry<>(EllGeometry{});
+  CHECK(ell.point_kind() == PolarKind::Identity);
+  CHECK(ell.line_kind() == PolarKind::Identity);
+  const auto hyp = fun::CKRuntimeGeometry<>(ck_diagonal(1, 1, -1));
+  CHECK(hyp.point_kind() == PolarKind::Signs);
+  CHECK(hyp.line_kind() == PolarKind::Signs);
+  const auto myck = fun::CKRuntimeGeometry<>(MyCKGeometry{});
+  CHECK(myck.point_kind() == PolarKind::Diagonal);
+  CHECK(myck.line_kind() == PolarKind::Diagonal);
+  const auto skew = fun::CKRuntimeGeometry<>(SkewGeometry{});
+  CHECK(skew.point_kind() == PolarKind::General);
+  CHECK(skew.line_kind() == PolarKind::General);
+  CHECK(skew.line_polar() == SkewGeometry::line_polar);
+
+  // a conic read at runtime
+  auto conic = CKMatrix{};
+  for (std::size_t k = 0; k != 3; ++k) {
+    conic[k][k] = int64_t(k) + 1;
+  }
+  const auto geom = fun::CKRuntimeGeometry<>(conic);
+  const auto l1 = PgLine({1, 2, 3});
+  const auto l2 = geom.perp(l1).circ(PgPoint({5, -1, 1}));
+  CHECK(geom.is_perpendicular(l1, l2));
+  CHECK(geom.is_perpendicular(l2, l1));
+}
+
+TEST_CASE("Runtime CK geometry over rationals") {
+  using Q = fun::Fraction<int64_t>;
+  using P = BasicPgPoint<Q>;
+  const auto geom = fun::CKRuntimeGeometry<P>(MyCKGeometry{});
+  const auto p = P({Q(1, 2), Q(3), Q(-1)});
+  CHECK(geom.perp(p) == BasicPgLine<Q>({Q(-1), Q(3), Q(2)}));
+  CHECK(geom.perp(geom.perp(p)) == p);
+  const auto batch = geom.perp(PgArray<P>(std::vector<P>{p, p}));
+  CHECK(batch[1] == geom.perp(p));
+}
@@ -0,0 +1,115 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <projgeom/collinear.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_plane.hpp>
+
+template <class P>
+static auto brute_force(const std::vector<P> &pts)
+    -> std::set<std::vector<uint32_t>> {
+  auto res = std::set<std::vector<uint32_t>>{};
+  for (uint32_t i = 0; i != pts.size(); ++i) {
+    for (uint32_t j = i + 1; j != pts.size(); ++j) {
+      auto grp = std::vector<uint32_t>{};
+      for (uint32_t k = 0; k != pts.size(); ++k) {
+        if (k == i || k == j || fun::coincident(pts[i], pts[j], pts[k])) {
+          grp.push_back(k);
+        }
+      }
+      if (grp.size() >= 3) {
+        res.insert(grp);
+      }
+    }
+  }
+  return res;
+}
+
+template <class C>
+static auto as_set(const fun::IncidenceGroups<C> &groups)
+    -> std::set<std::vector<uint32_t>> {
+  auto res = std::set<std::vector<uint32_t>>{};
+  for (std::size_t k = 0; k != groups.size(); ++k) {
+    const auto g = groups.group(k);
+    res.insert(std::vector<uint32_t>(g.begin(), g.end()));
+  }
+  return res;
+}
+
+TEST_CASE("Collinear groups of a 4 x 4 grid") {
+  auto pts = std::vector<PgPoint>{};
+  for (int64_t x = 0; x != 4; ++x) {
+    for (int64_t y = 0; y != 4; ++y) {
+      pts.push_back(PgPoint({x, y, 1}));
+    }
+  }
+  const auto groups = fun::collinear_groups(pts, 3);
+  // 4 rows, 4 columns, 2 diagonals of 4 and 4 diagonals of 3 points
+  CHECK_EQ(groups.size(), 14);
+  CHECK_EQ(groups.degenerate_pairs, 0);
+  CHECK(as_set(groups) == brute_force(pts));
+  for (std::size_t k = 0; k != groups.size(); ++k) {
+    for (const auto i : groups.group(k)) {
+      CHECK(pts[i].incident(groups.carriers[k]));
+    }
+  }
+}
+
+TEST_CASE("Collinear groups match brute force") {
+  std::mt19937_64 gen{2023};
+  std::uniform_int_distribution<int64_t> dist{-4, 4};
+  auto pts = std::vector<PgPoint>{};
+  auto seen = std::set<std::array<int64_t, 3>>{};
+  while (pts.size() != 60) {
+    const auto p = fun::canonicalize(PgPoint({dist(gen), dist(gen), 1}));
+    if (seen.insert(p.coord).second) {
+      pts.push_back(p);
+    }
+  }
+  const auto want = brute_force(pts);
+  for (const unsigned threads : {1U, 4U}) {
+    const auto groups = fun::collinear_groups(pts, threads);
+    CHECK(as_set(groups) == want);
+  }
+  CHECK(fun::collinear_groups(pts, 1).members ==
+        fun::collinear_groups(pts, 4).members);
+}
+
+#if PROJGEOM_HAS_INT128
+TEST_CASE("Collinear groups with coordinates beyond 2^31") {
+  // a 5 x 5 grid scaled by 2^40: the same groups, but the unreduced joins
+  // no longer fit in int64
+  auto pts = std::vector<PgPoint>{};
+  auto big = std::vector<PgPoint>{};
+  const auto s = int64_t(1) << 40;
+  for (int64_t x = 0; x != 5; ++x) {
+    for (int64_t y = 0; y != 5; ++y) {
+      pts.push_back(PgPoint({x, y, 1}));
+      big.push_back(PgPoint({s * x, s * y, s}));
+    }
+  }
+  const auto want = fun::collinear_groups(pts, 1);
+  const auto got = fun::collinear_groups(big, 4);
+  CHECK(got.carriers == want.carriers);
+  CHECK(got.offsets == want.offsets);
+  CHECK(got.members == want.members);
+}
+#endif
+
+TEST_CASE("Concurrent bundles (dual mode)") {
+  const auto o = PgPoint({2, -1, 3});
+  auto lns = std::vector<PgLine>{};
+  for (int64_t k = 1; k != 5; ++k) {
+    lns.push_back(o.circ(PgPoint({k, 1, -k})));
+  }
+  lns.push_back(PgLine({1, 0, 0}));
+  lns.push_back(PgLine({0, 1, 0}));
+  const auto groups = fun::concurrent_groups(lns);
+  REQUIRE(groups.size() == 1);
+  CHECK(groups.carriers[0] == o);
+  CHECK(as_set(groups) == brute_force(lns));
+}
@@ -0,0 +1,102 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+#include <projgeom/ck_plane.hpp>
+#include <projgeom/construction.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/pg_object.hpp>
+
+TEST_CASE("Construction of a projective figure") {
+  auto g = fun::Construction<PgPoint>{};
+  const auto a = g.point(PgPoint({1, 0, 1}));
+  const auto b = g.point(PgPoint({0, 1, 1}));
+  const auto c = g.point(PgPoint({1, 1, 1}));
+  const auto q = g.point(PgPoint({2, 3, 1}));
+  const auto ab = g.join(a, b);
+  const auto cq = g.join(c, q);
+  const auto d = g.meet(ab, cq); // on ab
+  const auto e = g.harm_conj(a, b, d);
+  const auto mirror = g.join(b, q);
+  const auto f = g.involution(c, mirror, a);
+  CHECK_EQ(g.size(), 10);
+  CHECK_EQ(g.level(e.id), 3);
+
+  const auto check = [&] {
+    CHECK(g[ab] == g[a].circ(g[b]));
+    CHECK(g[d] == g[ab].circ(g[cq]));
+    CHECK(g[e] == fun::harm_conj<int64_t>(g[a], g[b], g[d]));
+    CHECK(g[f] == fun::involution<int64_t>(g[c], g[mirror], g[a]));
+  };
+  check();
+
+  CHECK_EQ(g.update(), 0);
+  g.move(q, PgPoint({-1, 4, 2}));
+  CHECK_EQ(g.update(), 5); // cq, d, e, mirror, f; ab is untouched
+  check();
+  g.move(a, PgPoint({3, -1, 1}));
+  g.move(b, PgPoint({1, 1, 2}));
+  CHECK_EQ(g.update(), 5); // ab, d, e, mirror, f
+  check();
+}
+
+// The reflection has degree 9 in the vertex coordinates and is compared
+// by cross-multiplication, so int64 (and Fraction<int64_t>, whose
+// reductions do not shrink it enough) needs a small bound.
+template <class P>
+void check_triangle(uint64_t seed, int64_t bound) {
+  using T = typename P::value_type;
+  std::mt19937_64 gen{seed};
+  std::uniform_int_distribution<int64_t> dist{-bound, bound};
+  const auto rand = [&] {
+    return P({T(dist(gen)), T(dist(gen)), T(dist(gen))});
+  };
+  auto tri = std::array<P, 3>{rand(), rand(), rand()};
+  while (fun::coincident(tri[0], tri[1], tri[2])) {
+    tri[2] = rand();
+  }
+
+  auto g = fun::Construction<P>{};
+  const auto a1 = g.point(tri[0]);
+  const auto a2 = g.point(tri[1]);
+  const auto a3 = g.point(tri[2]);
+  const auto l1 = g.join(a2, a3);
+  const auto l2 = g.join(a1, a3);
+  const auto t1 = g.altitude(a1, l1);
+  const auto t2 = g.altitude(a2, l2);
+  const auto o = g.meet(t1, t2);
+  const auto pole = g.perp(l1);
+  const auto polar = g.perp(o);
+  const auto refl = g.reflect(l1, a1);
+
+  for (int frame = 0; frame != 20; ++frame) {
+    if (frame != 0) {
+      const auto k = std::size_t(frame) % 3;
+      do {
+        tri[k] = rand();
+      } while (fun::coincident(tri[0], tri[1], tri[2]));
+      g.move(std::array{a1, a2, a3}[k], tri[k]);
+      g.update();
+    }
+    const auto sides = fun::tri_dual(tri);
+    const auto alts = fun::tri_altitude(tri);
+    CHECK(g[l1] == sides[0]);
+    CHECK(g[t1] == alts[0]);
+    CHECK(g[t2] == alts[1]);
+    CHECK(g[o] == fun::orthocenter(tri));
+    CHECK(g[pole] == sides[0].perp());
+    CHECK(g[polar] == fun::orthocenter(tri).perp());
+    CHECK(g[refl] == fun::reflect<T>(tri[0], sides[0], tri[0]));
+  }
+}
+
+TEST_CASE("Construction of triangle centers") {
+  check_triangle<HypPoint>(1, 2);
+  check_triangle<BasicHypPoint<fun::Fraction<int64_t>>>(2, 2);
+#if PROJGEOM_HAS_INT128
+  check_triangle<BasicHypPoint<__int128>>(3, 6);
+#endif
+}
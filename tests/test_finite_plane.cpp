@@ -0,0 +1,36 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+
+#include <projgeom/finite_plane.hpp>
+
+TEST_CASE("PG(2, p) incidence matrix") {
+  const auto plane = fun::FinitePlane<7>{};
+  using Plane = fun::FinitePlane<7>;
+  CHECK(Plane::order == 57);
+  for (std::size_t i = 0; i != Plane::order; ++i) {
+    CHECK(Plane::index_of(Plane::point(i)) == i);
+  }
+  CHECK(plane.count_incidences() == 57 * 8);
+  CHECK(plane.check_axioms());
+  CHECK(plane.check_coincident() == 0);
+  CHECK(fun::FinitePlane<101>{}.check_axioms());
+}
+
+TEST_CASE("Pappus and Desargues hold in PG(2, p)") {
+  const auto plane5 = fun::FinitePlane<5>{};
+  const auto pappus = plane5.verify_pappus();
+  CHECK(pappus.checked == 9);
+  CHECK(pappus.failures == 0);
+  const auto desargue = plane5.verify_desargue();
+  CHECK(desargue.checked != 0);
+  CHECK(desargue.failures == 0);
+
+  const auto plane31 = fun::FinitePlane<31>{};
+  CHECK(plane31.check_axioms());
+  CHECK(plane31.verify_pappus().failures == 0);
+  const auto desargue31 = plane31.verify_desargue();
+  CHECK(desargue31.checked + desargue31.skipped == 30 * 30 * 30);
+  CHECK(desargue31.checked != 0);
+  CHECK(desargue31.failures == 0);
+}
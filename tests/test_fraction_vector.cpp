@@ -0,0 +1,44 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <projgeom/fraction_vector.hpp>
+
+TEST_CASE("FractionVector shares one denominator") {
+  using F = fun::Fraction<int64_t>;
+  const auto xs = std::vector<F>{F(1, 2), F(1, 3), F(-5, 6), F(2)};
+  const auto ys = std::vector<F>{F(1, 4), F(0), F(1, 3), F(-1, 2)};
+  auto u = fun::FractionVector<int64_t>(xs);
+  const auto v = fun::FractionVector<int64_t>(ys);
+  CHECK(u.den() == 6);
+  CHECK(v.den() == 12);
+  for (std::size_t i = 0; i != xs.size(); ++i) {
+    CHECK(u[i] == xs[i]);
+  }
+
+  const auto w = u + v;
+  CHECK(w.den() == 12);
+  for (std::size_t i = 0; i != xs.size(); ++i) {
+    CHECK(w[i] == xs[i] + ys[i]);
+    CHECK((u - v)[i] == xs[i] - ys[i]);
+  }
+
+  auto dot = F(0);
+  for (std::size_t i = 0; i != xs.size(); ++i) {
+    dot += xs[i] * ys[i];
+  }
+  CHECK(u.dot(v) == dot);
+
+  u *= F(3, 5);
+  CHECK(u.den() == 10);
+  for (std::size_t i = 0; i != xs.size(); ++i) {
+    CHECK(u[i] == xs[i] * F(3, 5));
+  }
+
+  auto z = fun::FractionVector<int64_t>({4, -8, 12}, -8);
+  CHECK(z.den() == 8);
+  CHECK(z.normalize() == 4);
+  CHECK(z.den() == 2);
+  CHECK(z.nums() == std::vector<int64_t>{-1, 2, -3});
+}
@@ -0,0 +1,54 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/fractions.hpp>
+
+TEST_CASE("binary gcd agrees with Euclid") {
+  std::mt19937_64 gen{7};
+  std::uniform_int_distribution<int64_t> dist{-(int64_t(1) << 40),
+                                              int64_t(1) << 40};
+  for (int i = 0; i != 1000; ++i) {
+    const auto a = dist(gen) * (i % 7 + 1);
+    const auto b = dist(gen) * (i % 5 + 1);
+    CHECK(fun::gcd(a, b) == fun::gcd_recur(a, b));
+  }
+  CHECK(fun::gcd(int64_t(0), int64_t(-6)) == 6);
+  CHECK(fun::gcd(int64_t(-12), int64_t(0)) == 12);
+  CHECK(fun::gcd(int32_t(-12), int32_t(18)) == 6);
+  CHECK(fun::lcm(int64_t(-4), int64_t(6)) == 12);
+  CHECK(fun::lcm(int64_t(0), int64_t(6)) == 0);
+#ifdef __SIZEOF_INT128__
+  const __int128 big = __int128(1) << 100;
+  CHECK(fun::gcd(big * 3, big * 5) == big);
+#endif
+}
+
+TEST_CASE("batched gcd reduction") {
+  std::vector<fun::Fraction<int64_t>> fracs;
+  std::vector<fun::Fraction<int64_t>> want;
+  for (int64_t i = 1; i != 40; ++i) {
+    auto f = fun::Fraction<int64_t>(i);
+    f._num = 6 * i;
+    f._den = (i % 2 == 0 ? -4 : 9) * i;
+    fracs.push_back(f);
+    want.emplace_back(6 * i, (i % 2 == 0 ? -4 : 9) * i);
+  }
+  fun::normalize_batch(fracs.data(), fracs.size());
+  for (std::size_t i = 0; i != fracs.size(); ++i) {
+    CHECK(fracs[i].num() == want[i].num());
+    CHECK(fracs[i].den() == want[i].den());
+  }
+
+  std::vector<std::array<int64_t, 3>> triples{
+      {6, -9, 12}, {0, 0, 0}, {0, 5, 10}, {7, 11, 13}, {-8, 4, 0}};
+  fun::normalize_batch(triples.data(), triples.size());
+  CHECK(triples[0] == std::array<int64_t, 3>{2, -3, 4});
+  CHECK(triples[1] == std::array<int64_t, 3>{0, 0, 0});
+  CHECK(triples[2] == std::array<int64_t, 3>{0, 1, 2});
+  CHECK(triples[3] == std::array<int64_t, 3>{7, 11, 13});
+  CHECK(triples[4] == std::array<int64_t, 3>{-2, 1, 0});
+}
@@ -0,0 +1,165 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/ck_plane.hpp>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/homography.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/myck_object.hpp>
+#include <projgeom/persp_object.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_plane.hpp>
+
+using H = fun::Homography<int64_t>;
+
+TEST_CASE("Homography maps points and lines consistently") {
+  const auto h = H{{{{2, 1, 0}, {-1, 3, 1}, {0, 1, 1}}}};
+  const auto p = PgPoint({1, 2, 3});
+  const auto q = PgPoint({-2, 1, 4});
+  const auto l = p.circ(q);
+  CHECK(h.map_point(p).incident(h.map_line(l)));
+  CHECK(h.map_point(p).circ(h.map_point(q)) == h.map_line(l));
+  CHECK(h.map_line(l).circ(h.map_line(PgLine({1, 1, 1}))) ==
+        h.map_point(l.circ(PgLine({1, 1, 1}))));
+
+  CHECK(h.inverse().map_point(h.map_point(p)) == p);
+  CHECK(h * h.inverse() == H::identity());
+  CHECK(h * H::identity() == h);
+  CHECK(H{{{{4, 2, 0}, {-2, 6, 2}, {0, 2, 2}}}} == h); // up to a factor
+  CHECK(h != H::identity());
+  CHECK_EQ(h.det(), 5);
+
+  const auto g = H{{{{1, 0, 5}, {0, 1, -3}, {0, 0, 1}}}};
+  CHECK((g * h).map_point(p) == g.map_point(h.map_point(p)));
+}
+
+#if PROJGEOM_HAS_INT128
+TEST_CASE("Homography from four correspondences") {
+  using P = BasicPgPoint<__int128>;
+  using HW = fun::Homography<__int128>;
+  const auto src = std::array<P, 4>{P({0, 0, 1}), P({1, 0, 1}), P({1, 1, 1}),
+                                    P({0, 1, 1})};
+  const auto dst = std::array<P, 4>{P({2, 3, 1}), P({7, -1, 2}),
+                                    P({5, 5, 1}), P({-1, 4, 3})};
+  const auto h = HW::from_points(src, dst);
+  for (std::size_t i = 0; i != 4; ++i) {
+    CHECK(h.map_point(src[i]) == dst[i]);
+  }
+  // unique: composing with the inverse fixes the frame
+  CHECK(HW::from_points(dst, src) == h.inverse());
+  // collinearity is preserved
+  const auto mid = P::plucker(1, src[0], 1, src[1]);
+  CHECK(fun::coincident(h.map_point(src[0]), h.map_point(src[1]),
+                        h.map_point(mid)));
+}
+#endif
+
+TEST_CASE("Homography over rationals") {
+  using Q = fun::Fraction<int64_t>;
+  using P = BasicPgPoint<Q>;
+  const auto h = fun::Homography<Q>{
+      {{{Q(1, 2), Q(0), Q(1)}, {Q(0), Q(2, 3), Q(0)}, {Q(0), Q(0), Q(1)}}}};
+  const auto p = h.map_point(P({Q(2), Q(3), Q(1)}));
+  CHECK(p == P({Q(2), Q(2), Q(1)}));
+  CHECK(h.inverse().map_point(p) == P({Q(2), Q(3), Q(1)}));
+}
+
+TEST_CASE("Batch application matches map_point/map_line") {
+  constexpr std::size_t n = 37; // exercises the scalar tail
+  std::mt19937_64 gen{2023};
+  std::uniform_int_distribution<int64_t> dist{-1000, 1000};
+  auto pts = std::vector<PgPoint>{};
+  auto lns = std::vector<PgLine>{};
+  for (std::size_t i = 0; i != n; ++i) {
+    pts.push_back(PgPoint({dist(gen), dist(gen), dist(gen)}));
+    lns.push_back(PgLine({dist(gen), dist(gen), dist(gen)}));
+  }
+  const auto h = H{{{{3, -1, 4}, {1, 5, -9}, {2, 6, 5}}}};
+  const auto mp = h.map_points(PgPointArray(pts));
+  const auto ml = h.map_lines(PgLineArray(lns));
+  for (std::size_t i = 0; i != n; ++i) {
+    CHECK(mp[i].coord == h.map_point(pts[i]).coord);
+    CHECK(ml[i].coord == h.map_line(lns[i]).coord);
+  }
+  auto buf = PgPointArray(pts);
+  h.map_points(buf, buf); // in place
+  CHECK(buf.coord == mp.coord);
+  auto lbuf = PgLineArray(n);
+  h.map_lines(PgLineArray(lns), lbuf);
+  CHECK(lbuf.coord == ml.coord);
+
+  using fun::simd::Isa;
+  const auto src = PgPointArray(pts);
+  auto want = PgPointArray(n);
+  auto got = PgPointArray(n);
+  fun::simd::kernels_for(Isa::Scalar)
+      .xform(src.columns(), h.mat, want.columns(), n);
+  for (auto isa : {Isa::Scalar, Isa::Avx2, Isa::Avx512}) {
+    fun::simd::kernels_for(isa).xform(src.columns(), h.mat, got.columns(), n);
+    CHECK(want.coord == got.coord);
+    // in place
+    auto inplace = src;
+    const auto c = inplace.columns();
+    fun::simd::kernels_for(isa).xform({c[0], c[1], c[2]}, h.mat, c, n);
+    CHECK(want.coord == inplace.coord);
+  }
+}
+
+template <class P, bool CK = true>
+void check_precompiled(int64_t seed) {
+  using T = typename P::value_type;
+  using L = typename P::Dual;
+  std::mt19937_64 gen{uint64_t(seed)};
+  std::uniform_int_distribution<int64_t> dist{-9, 9};
+  const auto rand = [&] { return T(dist(gen)); };
+  const auto origin = P({T(1), T(2), T(3)});
+  const auto mirror = L({T(2), T(-1), T(1)});
+  const auto inv = fun::make_involution(origin, mirror);
+  CHECK(inv * inv == fun::Homography<T>::identity());
+  auto pts = std::vector<P>{};
+  for (int k = 0; k != 20; ++k) {
+    const auto p = P({rand(), rand(), rand()});
+    if (p.coord == std::array<T, 3>{}) {
+      continue;
+    }
+    pts.push_back(p);
+    CHECK(inv.map_point(p) == fun::involution<T>(origin, mirror, p));
+  }
+  const auto batch = inv.map_points(PgArray<P>(pts));
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    CHECK(batch[i] == inv.map_point(pts[i]));
+  }
+  // the mirror is fixed (as a line), and so is every point on it
+  const auto q = P({T(1), T(2), T(0)});
+  CHECK(inv.map_line(mirror) == mirror);
+  CHECK(inv.map_point(q) == q);
+  if constexpr (CK) {
+    const auto refl = fun::make_reflection(mirror);
+    for (const auto &p : pts) {
+      CHECK(refl.map_point(p) == fun::reflect<T>(origin, mirror, p));
+    }
+  }
+}
+
+TEST_CASE("Harmonic conjugate") {
+  // x = 3/5 is the harmonic conjugate of x = 3 with respect to 0 and 1
+  const auto a = PgPoint({0, 0, 1});
+  const auto b = PgPoint({1, 0, 1});
+  const auto d = fun::harm_conj<int64_t>(a, b, PgPoint({3, 0, 1}));
+  CHECK(d == PgPoint({3, 0, 5}));
+  CHECK(fun::harm_conj<int64_t>(a, b, d) == PgPoint({3, 0, 1}));
+}
+
+TEST_CASE("Precompiled involution and reflection") {
+  check_precompiled<PgPoint, false>(1);
+  check_precompiled<EllPoint>(2);
+  check_precompiled<HypPoint>(3);
+  check_precompiled<PerspPoint>(4);
+  check_precompiled<MyCKPoint>(5);
+  check_precompiled<BasicEllPoint<fun::Fraction<int64_t>>>(6);
+}
@@ -0,0 +1,40 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+
+#include <projgeom/lazy_fraction.hpp>
+
+TEST_CASE("LazyFraction defers reduction") {
+  using LF = fun::LazyFraction<int64_t>;
+  auto a = LF(2, 4);
+  CHECK(a.num() == 2); // not reduced yet
+  CHECK(a.den() == 4);
+  CHECK(a == LF(1, 2));
+  CHECK(a.canonical() == fun::Fraction<int64_t>(1, 2));
+  CHECK(LF(3, -6).den() == 6);
+
+  auto b = a + LF(1, 4);
+  CHECK(b == LF(3, 4));
+  CHECK(b < LF(1));
+  CHECK(LF(1) > b);
+  CHECK(b - LF(3, 4) == int64_t(0));
+  CHECK(a * LF(4, 2) == int64_t(1));
+  CHECK(a / LF(-1, 2) == LF(-1));
+  b.reduce();
+  CHECK(b.num() == 3);
+  CHECK(b.den() == 4);
+}
+
+TEST_CASE("LazyFraction reduces past the threshold") {
+  using LF = fun::LazyFraction<int64_t>;
+  auto acc = LF(0);
+  for (int64_t i = 1; i != 200; ++i) {
+    acc += LF(1, i * (i + 1)); // telescopes to 1 - 1/(i+1)
+    CHECK(!acc.is_wide());
+  }
+  CHECK(acc.canonical() == fun::Fraction<int64_t>(199, 200));
+
+  auto big = LF(int64_t(3) << 40, int64_t(5) << 40);
+  CHECK(big.num() == 3);
+  CHECK(big.den() == 5);
+}
@@ -0,0 +1,50 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+
+#include <projgeom/common_concepts.h>
+#include <projgeom/modint.hpp>
+
+static_assert(fun::Integral<fun::ModInt<7>>);
+
+TEST_CASE("ModInt agrees with naive modular arithmetic") {
+  constexpr uint64_t p = (uint64_t(1) << 61) - 1;
+  using M = fun::ModInt<p>;
+  std::mt19937_64 gen{11};
+  std::uniform_int_distribution<int64_t> dist{INT64_MIN, INT64_MAX};
+  const auto residue = [](int64_t x) {
+    const auto r = x % int64_t(p);
+    return uint64_t(r < 0 ? r + int64_t(p) : r);
+  };
+  for (int i = 0; i != 1000; ++i) {
+    const auto x = dist(gen);
+    const auto y = dist(gen);
+    const auto a = residue(x);
+    const auto b = residue(y);
+    CHECK(M(x).value() == a);
+#if PROJGEOM_HAS_INT128
+    CHECK((M(x) * M(y)).value() ==
+          uint64_t((unsigned __int128)a * b % p));
+#endif
+    CHECK((M(x) + M(y)).value() == (a + b) % p);
+    CHECK((M(x) - M(y)).value() == (a + p - b) % p);
+    if (a != 0) {
+      CHECK(M(y) / M(x) * M(x) == M(y));
+    }
+  }
+}
+
+TEST_CASE("ModInt small prime field") {
+  using M = fun::ModInt<7>;
+  CHECK(M(-1).value() == 6);
+  CHECK(M(-7).value() == 0);
+  CHECK(M(3).inverse() == M(5));
+  CHECK(-M(2) == M(5));
+  CHECK(M(4) % M(3) == M(0));
+  CHECK(M(13) == M(6));
+  CHECK(M(5) < M(13)); // ordered by residue: 5 < 6
+  CHECK(!(M(13) < M(12))); // 6 < 5
+  constexpr auto c = M(3) * M(4);
+  static_assert(c == M(5));
+}
@@ -0,0 +1,111 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <thread>
+
+#include <projgeom/bigint.hpp>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/modular_verify.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_plane.hpp>
+
+TEST_CASE("Miller-Rabin") {
+  CHECK(fun::is_prime_u64(2));
+  CHECK(fun::is_prime_u64(1000003));
+  CHECK(!fun::is_prime_u64(1));
+  CHECK(!fun::is_prime_u64(1000001));
+  CHECK(fun::is_prime_u64((uint64_t(1) << 61) - 1));
+  CHECK(!fun::is_prime_u64(uint64_t(3215031751))); // strong pseudoprime 2,3,5,7
+  const auto basis = fun::RnsBasis<3>{42};
+  for (std::size_t i = 0; i != 3; ++i) {
+    CHECK(fun::is_prime_u64(basis.prime(i)));
+    CHECK(basis.prime(i) >> 60 == 1);
+  }
+}
+
+TEST_CASE("RnsInt arithmetic and CRT reconstruction") {
+  using R = fun::RnsInt<4>;
+  const auto b7 = fun::RnsBasis<4>{7};
+  const auto b8 = fun::RnsBasis<4>{8};
+  CHECK(b7.prime(0) != b8.prime(0));
+  CHECK(fun::RnsBasis<4>{7}.prime(0) == b7.prime(0));
+  const auto scope = fun::RnsScope<4>{b7};
+  const auto a = fun::BigInt{int64_t(1) << 50} * fun::BigInt{int64_t(1) << 50} +
+                 fun::BigInt{12345};
+  const auto b = -fun::BigInt{int64_t(987654321987654321)};
+  CHECK((R(a) * R(b)).to_big() == a * b);
+  CHECK((R(a) - R(a)).is_zero());
+  CHECK((R(-5) + R(3)).to_big() == fun::BigInt{-2});
+  CHECK(fun::BigInt{-7}.mod(5) == 3);
+  // values keep their own basis, whatever scope is current
+  const auto x = R(-5);
+  {
+    const auto inner = fun::RnsScope<4>{b8};
+    const auto y = R(-5);
+    CHECK(y.basis() == &b8);
+    CHECK(y.residue(0) == b8.prime(0) - 5);
+  }
+  CHECK(x.basis() == &b7);
+  CHECK(x.residue(0) == b7.prime(0) - 5);
+  CHECK((x * R(a)).to_big() == fun::BigInt{-5} * a);
+  // magnitude bounds: |3 * 5| < 2^(2 + 3), |x + 3| < 2^(3 + 1)
+  CHECK_EQ((R(3) * R(5)).bits(), 5);
+  CHECK_EQ((x + R(3)).bits(), 4);
+}
+
+TEST_CASE("modular verification of theorems with large coordinates") {
+  using R = fun::RnsInt<4>;
+  using P = BasicEllPoint<R>;
+  const auto basis = fun::RnsBasis<4>{3};
+  const auto scope = fun::RnsScope<4>{basis};
+  std::mt19937_64 gen{3};
+  std::uniform_int_distribution<int64_t> dist{-(int64_t(1) << 50),
+                                              int64_t(1) << 50};
+  const auto rnd = [&] {
+    return P({R(dist(gen)), R(dist(gen)), R(dist(gen))});
+  };
+  for (int i = 0; i != 20; ++i) {
+    const auto a = rnd();
+    const auto b = rnd();
+    const auto d = rnd();
+    const auto e = rnd();
+    const auto c = P::plucker(R(3), a, R(-5), b);
+    const auto f = P::plucker(R(7), d, R(2), e);
+    // the bound comes from the bit sizes the coordinates carry
+    const auto pappus = fun::modular_check(basis, [&] {
+      return fun::check_pappus(std::array<P, 3>{a, b, c},
+                               std::array<P, 3>{d, e, f});
+    });
+    CHECK(pappus.holds);
+    CHECK(pappus.error_bound > 0.0);
+    CHECK(pappus.error_bound < 1e-50);
+    const auto desargue = fun::modular_check(basis, [&] {
+      return fun::check_desargue(std::array<P, 3>{a, b, d},
+                                 std::array<P, 3>{e, c, f});
+    });
+    CHECK(desargue.holds);
+    CHECK(desargue.error_bound < 1e-50);
+    // a random triple is not collinear, and that answer is exact
+    const auto collinear =
+        fun::modular_check(basis, [&] { return fun::coincident(a, b, d); });
+    CHECK(!collinear.holds);
+    CHECK(collinear.error_bound == 0.0);
+  }
+}
+
+TEST_CASE("RnsInt scopes are per thread") {
+  using R = fun::RnsInt<2>;
+  const auto b1 = fun::RnsBasis<2>{1};
+  const auto b2 = fun::RnsBasis<2>{2};
+  const auto scope = fun::RnsScope<2>{b1};
+  auto other = R{};
+  std::thread([&] {
+    const auto inner = fun::RnsScope<2>{b2};
+    other = R(7) * R(6);
+  }).join();
+  CHECK(other.basis() == &b2);
+  CHECK(other.to_big() == fun::BigInt{42});
+  CHECK(R(1).basis() == &b1);
+}
@@ -0,0 +1,104 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/oriented_object.hpp>
+
+TEST_CASE("Oriented points and lines") {
+  const auto p = OrientedPoint({0, 0, 1});
+  const auto q = OrientedPoint({4, 0, 1});
+  const auto r = OrientedPoint({0, 3, 1}); // counterclockwise from p, q
+  const auto l = p.circ(q);
+
+  CHECK(p.incident(l));
+  CHECK(q.incident(l));
+  CHECK(q.circ(p) == -l); // the join is anti-commutative
+  CHECK_EQ(r.side(l), 1);
+  CHECK_EQ(OrientedPoint({0, -3, 1}).side(l), -1);
+  CHECK_EQ(OrientedPoint({7, 0, 2}).side(l), 0);
+  CHECK_EQ(q.circ(p).side(r), -1);
+
+  // orientation is significant: -p is the antipode of p
+  CHECK(OrientedPoint({0, 3, 1}) == OrientedPoint({0, 6, 2}));
+  CHECK(r != -r);
+  CHECK(-r == OrientedPoint({0, -6, -2}));
+  CHECK_EQ((-r).side(l), -1);
+  CHECK_EQ(r.side(-l), -1);
+
+  // exact even when the dot product overflows int64
+  constexpr int64_t big = int64_t(1) << 62;
+  const auto m = OrientedLine({big, big, -1});
+  CHECK_EQ(OrientedPoint({big, big, 1}).side(m), 1);
+  CHECK_EQ(OrientedPoint({big, -big, 1}).side(m), -1);
+  // 2^63 + 2^63 wraps to 0 in int64
+  CHECK_FALSE(OrientedPoint({big, big, 1}).incident(OrientedLine({2, 2, 0})));
+}
+
+TEST_CASE("side_of matches side") {
+  constexpr std::size_t n = 1000; // several words, partial last word
+  std::mt19937_64 gen{2023};
+  for (const int bits : {10, 40}) {
+    // bits = 40 forces the exact path, bits = 10 the SIMD kernel
+    std::uniform_int_distribution<int64_t> dist{-(int64_t(1) << bits),
+                                                int64_t(1) << bits};
+    std::uniform_int_distribution<int64_t> ends{-(1 << 20), 1 << 20};
+    const auto a = OrientedPoint({ends(gen), ends(gen), 1});
+    const auto b = OrientedPoint({ends(gen), ends(gen), 1});
+    const auto l = a.circ(b);
+    auto pts = OrientedPointArray{};
+    for (std::size_t i = 0; i != n; ++i) {
+      // every third point on the line
+      pts.push_back(i % 3 == 0 ? OrientedPoint::plucker(int64_t(i % 7), a,
+                                                        int64_t(i % 5), b)
+                               : OrientedPoint({dist(gen), dist(gen), 1}));
+    }
+    const auto masks = fun::side_of(l, pts);
+    auto counts = std::array<std::size_t, 3>{};
+    for (std::size_t i = 0; i != n; ++i) {
+      const auto s = pts[i].side(l);
+      CHECK_EQ(masks.side(i), s);
+      ++counts[std::size_t(s + 1)];
+    }
+    CHECK_EQ(masks.count_neg(), counts[0]);
+    CHECK_EQ(masks.count_on(), counts[1]);
+    CHECK_EQ(masks.count_pos(), counts[2]);
+    CHECK(counts[1] >= n / 3);
+
+    const auto on = masks.indices(0);
+    CHECK_EQ(on.size(), counts[1]);
+    for (const auto i : on) {
+      CHECK(pts[i].incident(l));
+    }
+    for (const auto i : masks.indices(1)) {
+      CHECK_EQ(pts[i].side(l), 1);
+    }
+  }
+}
+
+TEST_CASE("SIMD sign kernels agree with the scalar fallback") {
+  using fun::simd::Isa;
+  constexpr std::size_t n = 200;
+  std::mt19937_64 gen{42};
+  std::uniform_int_distribution<int64_t> dist{-(int64_t(1) << 4),
+                                              int64_t(1) << 4};
+  std::vector<int64_t> buf(3 * n);
+  for (auto &v : buf) {
+    v = dist(gen);
+  }
+  const int64_t *in = buf.data();
+  const fun::simd::ConstColumns a{in, in + n, in + 2 * n};
+  const fun::simd::Triple b{3, -2, 1};
+  constexpr auto words = (n + 63) / 64;
+  std::vector<uint64_t> want(2 * words);
+  std::vector<uint64_t> got(2 * words);
+  fun::simd::kernels_for(Isa::Scalar)
+      .sign1(a, b, want.data(), want.data() + words, n);
+  for (auto isa : {Isa::Scalar, Isa::Avx2, Isa::Avx512}) {
+    fun::simd::kernels_for(isa).sign1(a, b, got.data(), got.data() + words,
+                                      n);
+    CHECK(want == got);
+  }
+}
@@ -0,0 +1,44 @@
+#include <doctest/doctest.h>
+
+#include <projgeom/ell_object.hpp>
+#include <projgeom/pg_array.hpp>
+#include <projgeom/pg_object.hpp>
+
+TEST_CASE("PgArray batch circ/dot/incident") {
+  auto pts = PgPointArray(std::vector<PgPoint>{
+      PgPoint({1, 3, 2}), PgPoint({-2, 1, -1}), PgPoint({2, -2, 1})});
+  auto qts = PgPointArray(std::vector<PgPoint>{
+      PgPoint({4, -1, 3}), PgPoint({0, 5, 7}), PgPoint({3, 3, -4})});
+  CHECK(pts.size() == 3);
+  const auto lns = pts.circ(qts);
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    CHECK(lns[i] == pts[i].circ(qts[i]));
+  }
+  const auto inc_p = pts.incident(lns);
+  const auto inc_q = qts.incident(lns);
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    CHECK(inc_p[i] == 1);
+    CHECK(inc_q[i] == 1);
+  }
+  const auto r = PgPoint({1, 1, 1});
+  const auto dots = lns.dot(r);
+  const auto lr = pts.circ(r);
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    CHECK(dots[i] == lns[i].dot(r));
+    CHECK(lr[i] == pts[i].circ(r));
+  }
+}
+
+TEST_CASE("PgArray plucker with CK geometry") {
+  auto pts = PgArray<EllPoint>(std::vector<EllPoint>{
+      EllPoint({1, 3, 2}), EllPoint({-2, 1, -1})});
+  auto qts = PgArray<EllPoint>(std::vector<EllPoint>{
+      EllPoint({4, -1, 3}), EllPoint({0, 5, 7})});
+  const auto ln = pts.circ(qts);
+  const auto rs = PgArray<EllPoint>::plucker(3, pts, -5, qts);
+  const auto inc = rs.incident(ln);
+  for (std::size_t i = 0; i != rs.size(); ++i) {
+    CHECK(rs[i] == EllPoint::plucker(3, pts[i], -5, qts[i]));
+    CHECK(inc[i] == 1);
+  }
+}
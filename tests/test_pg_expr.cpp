@@ -0,0 +1,63 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+#include <projgeom/ck_plane.hpp>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/myck_object.hpp>
+#include <projgeom/pg_expr.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_plane.hpp>
+
+template <class P> auto random_point(std::mt19937_64 &gen) -> P {
+  using T = typename P::value_type;
+  std::uniform_int_distribution<int64_t> dist{-100, 100};
+  return P({T(dist(gen)), T(dist(gen)), T(dist(gen))});
+}
+
+template <class P> void check_fused_matches_eager() {
+  using T = typename P::value_type;
+  std::mt19937_64 gen{5};
+  for (int i = 0; i != 100; ++i) {
+    const auto a = random_point<P>(gen);
+    const auto b = random_point<P>(gen);
+    const auto d = random_point<P>(gen);
+    const auto e = random_point<P>(gen);
+    const auto c = P::plucker(T(2), a, T(-3), b);
+    const auto f = P::plucker(T(1), d, T(4), e);
+    const auto chain = fun::expr::circ(fun::expr::circ(a, e),
+                                       fun::expr::circ(b, d));
+    const auto comb = fun::expr::plucker(T(2), a, T(-3), b);
+    CHECK(fun::expr::eval(chain).coord == a.circ(e).circ(b.circ(d)).coord);
+    CHECK(fun::expr::eval(comb).coord == c.coord);
+    CHECK(fun::expr::dot(fun::expr::circ(a, b), d) == a.circ(b).dot(d));
+    CHECK(fun::expr::dot(e, fun::expr::circ(a, b)) == e.dot(a.circ(b)));
+    CHECK(fun::expr::coincident(a, b, c));
+    CHECK_FALSE(fun::expr::coincident(a, b, d));
+    CHECK(fun::expr::check_pappus(std::array<P, 3>{a, b, c},
+                                  std::array<P, 3>{d, e, f}));
+    if constexpr (requires { a.perp(); }) {
+      const auto tri = std::array<P, 3>{a, b, d};
+      CHECK(fun::expr::orthocenter(tri).coord == fun::orthocenter(tri).coord);
+    }
+  }
+}
+
+TEST_CASE("expression templates agree with eager evaluation") {
+  // int64: the Pappus determinant overflows, but incidence goes through the
+  // exact det3_is_zero
+  check_fused_matches_eager<PgPoint>();
+  check_fused_matches_eager<EllPoint>();
+  check_fused_matches_eager<HypPoint>();
+  check_fused_matches_eager<MyCKPoint>();
+#if PROJGEOM_HAS_INT128
+  // __int128: the Pappus determinant has degree 12 in the coordinates
+  check_fused_matches_eager<BasicPgPoint<__int128>>();
+  check_fused_matches_eager<BasicEllPoint<__int128>>();
+  check_fused_matches_eager<BasicHypPoint<__int128>>();
+  check_fused_matches_eager<BasicMyCKPoint<__int128>>();
+#endif
+}
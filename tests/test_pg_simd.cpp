@@ -0,0 +1,58 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/pg_simd.hpp>
+
+using fun::simd::Isa;
+
+TEST_CASE("SIMD kernels agree with the scalar fallback") {
+  constexpr std::size_t n = 37; // exercises the scalar tail
+  std::mt19937_64 gen{42};
+  std::uniform_int_distribution<int64_t> dist{-(int64_t(1) << 30),
+                                              int64_t(1) << 30};
+  std::vector<int64_t> buf(8 * n);
+  for (auto &v : buf) {
+    v = dist(gen);
+  }
+  const int64_t *in = buf.data();
+  const fun::simd::ConstColumns a{in, in + n, in + 2 * n};
+  const fun::simd::ConstColumns b{in + 3 * n, in + 4 * n, in + 5 * n};
+  const int64_t *ld = in + 6 * n;
+  const int64_t *mu = in + 7 * n;
+  const fun::simd::Triple b1{buf[1], buf[2], buf[3]};
+
+  const auto &ref = fun::simd::kernels_for(Isa::Scalar);
+  std::vector<int64_t> want(4 * n);
+  std::vector<int64_t> got(4 * n);
+  auto cols = [n](std::vector<int64_t> &v) -> fun::simd::Columns {
+    return {v.data(), v.data() + n, v.data() + 2 * n};
+  };
+
+  for (auto isa : {Isa::Scalar, Isa::Avx2, Isa::Avx512}) {
+    const auto &ker = fun::simd::kernels_for(isa);
+    CHECK(ker.isa <= fun::simd::kernels().isa);
+
+    ref.cross(a, b, cols(want), n);
+    ker.cross(a, b, cols(got), n);
+    CHECK(want == got);
+
+    ref.cross1(a, b1, cols(want), n);
+    ker.cross1(a, b1, cols(got), n);
+    CHECK(want == got);
+
+    ref.dot(a, b, want.data(), n);
+    ker.dot(a, b, got.data(), n);
+    CHECK(want == got);
+
+    ref.dot1(a, b1, want.data(), n);
+    ker.dot1(a, b1, got.data(), n);
+    CHECK(want == got);
+
+    ref.plckr(ld, a, mu, b, cols(want), n);
+    ker.plckr(ld, a, mu, b, cols(got), n);
+    CHECK(want == got);
+  }
+}
@@ -0,0 +1,148 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/bigint.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_plane.hpp>
+#include <projgeom/predicates.hpp>
+
+using fun::simd::Isa;
+using Triple = std::array<int64_t, 3>;
+
+static auto big_orient(const Triple &a, const Triple &b, const Triple &c)
+    -> int {
+  const auto big = [](const Triple &x) {
+    return std::array<fun::BigInt, 3>{fun::BigInt{x[0]}, fun::BigInt{x[1]},
+                                      fun::BigInt{x[2]}};
+  };
+  return fun::det3(big(a), big(b), big(c)).sign();
+}
+
+TEST_CASE("orient on int64 is exact") {
+  std::mt19937_64 gen{2023};
+  for (const int bits : {10, 40, 62}) {
+    std::uniform_int_distribution<int64_t> dist{-(int64_t(1) << bits),
+                                                int64_t(1) << bits};
+    for (int k = 0; k != 200; ++k) {
+      const auto a = Triple{dist(gen), dist(gen), dist(gen)};
+      const auto b = Triple{dist(gen), dist(gen), dist(gen)};
+      const auto c = Triple{dist(gen), dist(gen), dist(gen)};
+      CHECK_EQ(fun::orient(a, b, c), big_orient(a, b, c));
+      // d, e and d + e are collinear (halved so that the sum cannot wrap)
+      const auto d = Triple{a[0] / 2, a[1] / 2, a[2] / 2};
+      const auto e = Triple{b[0] / 2, b[1] / 2, b[2] / 2};
+      const auto f = Triple{d[0] + e[0], d[1] + e[1], d[2] + e[2]};
+      CHECK_EQ(fun::orient(d, e, f), 0);
+    }
+  }
+}
+
+TEST_CASE("orient on double falls back to exact arithmetic") {
+  // 0.1 * 3 != 0.3 in binary: the naive determinant is a rounding artifact
+  const auto a = std::array<double, 3>{0.1, 0.2, 0.3};
+  const auto b = std::array<double, 3>{0.3, 0.6, 0.9};
+  const auto c = std::array<double, 3>{1.0, -2.0, 0.5};
+  CHECK_EQ(fun::orient(a, a, c), 0);
+  CHECK_EQ(fun::orient(a, b, c), -fun::orient(b, a, c));
+
+  // exactly collinear: b2 = 3 * a2 in binary as well
+  const auto a2 = std::array<double, 3>{0.125, 0.25, 0.375};
+  const auto b2 = std::array<double, 3>{0.375, 0.75, 1.125};
+  CHECK_EQ(fun::orient(a2, b2, c), 0);
+
+  // tiny perturbation far below the filter threshold
+  auto b3 = b2;
+  b3[2] = std::nextafter(b3[2], 2.0);
+  CHECK(fun::orient(a2, b3, c) != 0);
+  CHECK_EQ(fun::orient(a2, b3, c), -fun::orient(b3, a2, c));
+}
+
+TEST_CASE("orient_batch agrees with orient") {
+  constexpr std::size_t n = 300; // more than one chunk, with a tail
+  std::mt19937_64 gen{7};
+  for (const int bits : {8, 40}) {
+    std::uniform_int_distribution<int64_t> dist{-(int64_t(1) << bits),
+                                                int64_t(1) << bits};
+    std::vector<int64_t> buf(9 * n);
+    for (auto &v : buf) {
+      v = dist(gen);
+    }
+    // make some triples degenerate
+    for (std::size_t j = 0; j < n; j += 5) {
+      for (std::size_t k = 0; k != 3; ++k) {
+        buf[(6 + k) * n + j] = buf[k * n + j] - buf[(3 + k) * n + j];
+      }
+    }
+    const int64_t *in = buf.data();
+    const fun::simd::ConstColumns a{in, in + n, in + 2 * n};
+    const fun::simd::ConstColumns b{in + 3 * n, in + 4 * n, in + 5 * n};
+    const fun::simd::ConstColumns c{in + 6 * n, in + 7 * n, in + 8 * n};
+    std::vector<int8_t> sign(n);
+    fun::orient_batch(a, b, c, sign.data(), n);
+    for (std::size_t j = 0; j != n; ++j) {
+      const auto want =
+          fun::orient(Triple{a[0][j], a[1][j], a[2][j]},
+                      Triple{b[0][j], b[1][j], b[2][j]},
+                      Triple{c[0][j], c[1][j], c[2][j]});
+      CHECK_EQ(int(sign[j]), want);
+      if (j % 5 == 0) {
+        CHECK_EQ(want, 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("SIMD det3 kernels agree with the scalar fallback") {
+  constexpr std::size_t n = 37;
+  std::mt19937_64 gen{42};
+  std::uniform_int_distribution<int64_t> dist{-(int64_t(1) << 20),
+                                              int64_t(1) << 20};
+  std::vector<int64_t> buf(9 * n);
+  for (auto &v : buf) {
+    v = dist(gen);
+  }
+  const int64_t *in = buf.data();
+  const fun::simd::ConstColumns a{in, in + n, in + 2 * n};
+  const fun::simd::ConstColumns b{in + 3 * n, in + 4 * n, in + 5 * n};
+  const fun::simd::ConstColumns c{in + 6 * n, in + 7 * n, in + 8 * n};
+  std::vector<int64_t> want(n);
+  std::vector<int64_t> got(n);
+  fun::simd::kernels_for(Isa::Scalar).det3(a, b, c, want.data(), n);
+  for (auto isa : {Isa::Scalar, Isa::Avx2, Isa::Avx512}) {
+    fun::simd::kernels_for(isa).det3(a, b, c, got.data(), n);
+    CHECK(want == got);
+  }
+}
+
+// int64 coincident() is exact at run time and still usable at compile time
+static_assert(fun::coincident(PgPoint({1, 3, 2}), PgPoint({-2, 1, -1}),
+                              PgPoint({-1, 4, 1})));
+static_assert(!fun::coincident(PgPoint({1, 3, 2}), PgPoint({-2, 1, -1}),
+                               PgPoint({0, 0, 1})));
+static_assert(fun::persp(std::array{PgPoint({1, 0, 0}), PgPoint({0, 1, 0}),
+                                    PgPoint({0, 0, 1})},
+                         std::array{PgPoint({2, 1, 1}), PgPoint({1, 2, 1}),
+                                    PgPoint({1, 1, 2})}));
+
+TEST_CASE("coincident and persp via det3") {
+  const auto p = PgPoint({1, 3, 2});
+  const auto q = PgPoint({-2, 1, -1});
+  const auto r = PgPoint::plucker(2, p, 3, q);
+  CHECK(fun::coincident(p, q, r));
+  CHECK(!fun::coincident(p, q, PgPoint({0, 0, 1})));
+
+  const auto s = PgPoint({2, 7, -1});
+  const auto o = PgPoint({3, 1, 5});
+  const auto tri1 = std::array{p, q, s};
+  auto tri2 = std::array{PgPoint::plucker(1, o, 2, p),
+                         PgPoint::plucker(1, o, -3, q),
+                         PgPoint::plucker(2, o, 5, s)};
+  CHECK(fun::persp(tri1, tri2));
+  tri2[2] = PgPoint({1, -4, 3});
+  CHECK(!fun::persp(tri1, tri2));
+}
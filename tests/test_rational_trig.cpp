@@ -0,0 +1,119 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/ell_object.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/myck_object.hpp>
+#include <projgeom/rational_trig.hpp>
+
+using Q = fun::Fraction<int64_t>;
+
+TEST_CASE("Quadrance and spread in the elliptic plane") {
+  const auto c = EllPoint({0, 0, 1});
+  const auto a = EllPoint({1, 0, 1});
+  const auto b = EllPoint({0, 2, 1});
+  const auto q1 = fun::quadrance(c, a);
+  const auto q2 = fun::quadrance(c, b);
+  const auto q3 = fun::quadrance(a, b);
+  CHECK(q1 == Q(1, 2));
+  CHECK(q2 == Q(4, 5));
+  CHECK(q3 == Q(9, 10));
+  // the right angle at c: Pythagoras' theorem
+  CHECK(fun::spread(c.circ(a), c.circ(b)) == Q(1));
+  CHECK(fun::cross_s(c.circ(a), c.circ(b)) == Q(0));
+  CHECK(q3 == q1 + q2 - q1 * q2);
+  CHECK(fun::quadrance(a, a) == Q(0));
+
+#if PROJGEOM_HAS_INT128
+  // B(a, a) B(b, b) is about 2^88 here, but the quadrance is still 9/10
+  constexpr int64_t k = int64_t(1) << 20;
+  const auto ka = EllPoint({k, 0, k});
+  const auto kb = EllPoint({0, 2 * k, k});
+  CHECK(fun::quadrance(ka, kb) == q3);
+  CHECK(fun::quadrance(ka, ka) == Q(0));
+#endif
+}
+
+template <class P> void check_duality(uint64_t seed) {
+  std::mt19937_64 gen{seed};
+  std::uniform_int_distribution<int64_t> dist{-50, 50};
+  for (int k = 0; k != 50; ++k) {
+    const auto a = P({dist(gen), dist(gen), dist(gen)});
+    const auto b = P({dist(gen), dist(gen), dist(gen)});
+    if (a.dot(a.perp()) == 0 || b.dot(b.perp()) == 0) {
+      continue; // null points
+    }
+    const auto l = a.circ(b);
+    const auto m = b.circ(P({1, 2, 3}));
+    if (l.dot(l.perp()) == 0 || m.dot(m.perp()) == 0) {
+      continue;
+    }
+    // quadrance is the spread of the polars; spread + cross = 1
+    CHECK(fun::quadrance(a, b) == fun::spread(a.perp(), b.perp()));
+    CHECK(fun::spread(l, m) + fun::cross_s(l, m) == Q(1));
+  }
+}
+
+TEST_CASE("Quadrance is dual to spread") {
+  check_duality<EllPoint>(1);
+  check_duality<HypPoint>(2);
+  check_duality<MyCKPoint>(3);
+}
+
+template <class P> void check_matrix(uint64_t seed) {
+  std::mt19937_64 gen{seed};
+  std::uniform_int_distribution<int64_t> dist{-30, 30};
+  using T = typename P::value_type;
+  auto pts = std::vector<P>{};
+  while (pts.size() != 101) {
+    const auto p = P({T(dist(gen)), T(dist(gen)), T(dist(gen))});
+    if (p.dot(p.perp()) != T(0)) {
+      pts.push_back(p);
+    }
+  }
+  auto lns = std::vector<typename P::Dual>{};
+  for (std::size_t i = 0; i + 1 != pts.size(); ++i) {
+    lns.push_back(pts[i].circ(pts[i + 1]));
+  }
+  for (const unsigned threads : {1U, 4U}) {
+    const auto qm = fun::quadrance_matrix(pts, threads, 16);
+    REQUIRE(qm.n == pts.size());
+    for (std::size_t i = 0; i != pts.size(); ++i) {
+      for (std::size_t j = 0; j != pts.size(); ++j) {
+        CHECK(qm.at(i, j) == fun::quadrance(pts[i], pts[j]));
+      }
+    }
+    const auto sm = fun::spread_matrix(lns, threads, 7);
+    for (std::size_t i = 0; i != lns.size(); ++i) {
+      for (std::size_t j = 0; j != lns.size(); ++j) {
+        if (sm.den[sm.index(i, j)] != T(0)) {
+          CHECK(sm.at(i, j) == fun::spread(lns[i], lns[j]));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("All-pairs measure matrices match the scalar functions") {
+  check_matrix<EllPoint>(4);
+  check_matrix<HypPoint>(5);
+  check_matrix<BasicMyCKPoint<fun::Fraction<int64_t>>>(6);
+
+#if PROJGEOM_HAS_INT128
+  // past the int64 range of the fused rows: the entries are still exact
+  constexpr int64_t k = int64_t(1) << 20;
+  const auto pts = std::vector{EllPoint({k, 0, k}), EllPoint({0, 2 * k, k}),
+                               EllPoint({1, 2, 3})};
+  const auto qm = fun::quadrance_matrix(pts);
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    for (std::size_t j = 0; j != pts.size(); ++j) {
+      CHECK(qm.at(i, j) == fun::quadrance(pts[i], pts[j]));
+    }
+  }
+  CHECK(qm.at(0, 1) == Q(9, 10));
+#endif
+}
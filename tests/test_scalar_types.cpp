@@ -0,0 +1,85 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+
+#include <projgeom/adaptive_int.hpp>
+#include <projgeom/ck_plane.hpp>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/modint.hpp>
+#include <projgeom/myck_object.hpp>
+#include <projgeom/persp_object.hpp>
+#include <projgeom/pg_array.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_plane.hpp>
+
+template <class P> void check_theorems() {
+  using T = typename P::value_type;
+  const auto p = P({T(1), T(3), T(2)});
+  const auto q = P({T(-2), T(1), T(-1)});
+  const auto r = P({T(2), T(-2), T(1)});
+  const auto s = P({T(2), T(1), T(1)});
+  const auto t = P({T(0), T(2), T(-1)});
+  const auto u = P({T(3), T(1), T(1)});
+  const auto l = p.circ(q);
+  CHECK(fun::check_axiom(p, q, l));
+  CHECK(fun::check_axiom2(p, q, l, T(3), T(-4)));
+  CHECK(fun::check_pappus(
+      std::array<P, 3>{p, q, P::plucker(T(2), p, T(3), q)},
+      std::array<P, 3>{r, s, P::plucker(T(1), r, T(-1), s)}));
+  CHECK(fun::check_desargue(std::array<P, 3>{p, q, r},
+                            std::array<P, 3>{s, t, u}));
+}
+
+template <class P> void check_ck() {
+  using T = typename P::value_type;
+  const auto a1 = P({T(1), T(3), T(2)});
+  const auto a2 = P({T(-2), T(1), T(-1)});
+  const auto a3 = P({T(2), T(-2), T(1)});
+  const auto tri = std::array<P, 3>{a1, a2, a3};
+  const auto o = fun::orthocenter(tri);
+  const auto [t1, t2, t3] = fun::tri_altitude(tri);
+  const auto mirror = a2.circ(a3);
+  const auto refl = fun::reflect<T>(a1, mirror, a1);
+  CHECK(fun::is_perpendicular(t1, mirror));
+  CHECK(t3.incident(o));
+  CHECK(fun::coincident(a1, refl, mirror.perp()));
+}
+
+TEST_CASE("PgObject with various scalar types") {
+  check_theorems<BasicPgPoint<int32_t>>();
+  check_theorems<PgPoint>();
+#if PROJGEOM_HAS_INT128
+  check_theorems<BasicPgPoint<__int128>>();
+#endif
+  check_theorems<BasicPgPoint<double>>();
+  check_theorems<BasicPgPoint<fun::Fraction<int64_t>>>();
+  check_theorems<BasicPgPoint<fun::AdaptiveInt>>();
+  check_theorems<BasicPgPoint<fun::ModInt<1000003>>>();
+  check_theorems<BasicPgLine<int64_t>>();
+}
+
+TEST_CASE("CK geometries with various scalar types") {
+  check_ck<BasicEllPoint<int32_t>>();
+  check_ck<EllPoint>();
+  check_ck<BasicHypPoint<double>>();
+  check_ck<BasicMyCKPoint<fun::Fraction<int64_t>>>();
+#if PROJGEOM_HAS_INT128
+  check_ck<BasicPerspPoint<__int128>>();
+#endif
+  check_ck<BasicEllPoint<fun::ModInt<1000003>>>();
+  check_ck<BasicMyCKPoint<fun::ModInt<(uint64_t(1) << 61) - 1>>>();
+}
+
+TEST_CASE("PgArray with int32 columns") {
+  using P = BasicPgPoint<int32_t>;
+  auto pts = PgArray<P>(std::vector<P>{P({1, 3, 2}), P({-2, 1, -1})});
+  auto qts = PgArray<P>(std::vector<P>{P({4, -1, 3}), P({0, 5, 7})});
+  const auto lns = pts.circ(qts);
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    CHECK(lns[i] == pts[i].circ(qts[i]));
+    CHECK(pts.incident(lns)[i] == 1);
+  }
+}
@@ -0,0 +1,81 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <projgeom/ck_plane.hpp>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/myck_object.hpp>
+#include <projgeom/persp_object.hpp>
+#include <projgeom/triangle_batch.hpp>
+
+template <class P> void check_centers(uint64_t seed, std::size_t n) {
+  using T = typename P::value_type;
+  std::mt19937_64 gen{seed};
+  // the incidence checks have degree 9 in the coordinates
+  std::uniform_int_distribution<int64_t> dist{-40, 40};
+  const auto rand = [&] {
+    return P({T(dist(gen)), T(dist(gen)), T(dist(gen))});
+  };
+  auto tris = std::vector<std::array<P, 3>>{};
+  while (tris.size() != n) {
+    const auto tri = std::array<P, 3>{rand(), rand(), rand()};
+    if (!fun::coincident(tri[0], tri[1], tri[2])) {
+      tris.push_back(tri);
+    }
+  }
+  const auto arr = fun::TriangleArray<P>(tris);
+  CHECK(arr[n - 1] == tris[n - 1]);
+  for (const unsigned threads : {1U, 3U}) {
+    const auto res = fun::triangle_centers(arr, threads, 100);
+    for (std::size_t i = 0; i != n; ++i) {
+      const auto &tri = tris[i];
+      const auto sides = fun::tri_dual(tri);
+      const auto alts = fun::tri_altitude(tri);
+      for (std::size_t k = 0; k != 3; ++k) {
+        CHECK(res.sides[k][i].coord == sides[k].coord);
+        CHECK(res.poles[k][i].coord == sides[k].perp().coord);
+        CHECK(res.altitudes[k][i].coord == alts[k].coord);
+        CHECK(res.orthic[k][i].coord == alts[k].circ(sides[k]).coord);
+        CHECK(res.orthic[k][i].incident(sides[k]));
+      }
+      CHECK(res.orthocenter[i].coord == fun::orthocenter(tri).coord);
+      CHECK(alts[2].incident(res.orthocenter[i]));
+    }
+  }
+
+  // only the requested outputs, reusing the output arrays
+  using TO = fun::TriangleOutput;
+  auto res = fun::triangle_centers(arr);
+  fun::triangle_centers(fun::TriangleArray<P>(std::vector(tris.begin(),
+                                                          tris.begin() + 10)),
+                        res, TO::Orthocenter);
+  CHECK_EQ(res.orthocenter.size(), 10);
+  CHECK_EQ(res.sides[0].size(), 0);
+  CHECK_EQ(res.orthic[2].size(), 0);
+  CHECK(res.orthocenter[9].coord == fun::orthocenter(tris[9]).coord);
+
+  fun::triangle_centers(arr, res, TO::Orthic | TO::Poles, 2, 100);
+  CHECK_EQ(res.orthocenter.size(), 0);
+  CHECK_EQ(res.altitudes[1].size(), 0);
+  for (std::size_t i = 0; i != n; ++i) {
+    const auto sides = fun::tri_dual(tris[i]);
+    const auto alts = fun::tri_altitude(tris[i]);
+    for (std::size_t k = 0; k != 3; ++k) {
+      CHECK(res.poles[k][i].coord == sides[k].perp().coord);
+      CHECK(res.orthic[k][i].coord == alts[k].circ(sides[k]).coord);
+    }
+  }
+}
+
+TEST_CASE("Batch triangle centers match the scalar functions") {
+  check_centers<EllPoint>(1, 1500); // several blocks per chunk
+  check_centers<HypPoint>(2, 300);
+  check_centers<MyCKPoint>(3, 300);
+  check_centers<PerspPoint>(4, 300);
+  check_centers<BasicHypPoint<fun::Fraction<int64_t>>>(5, 50);
+}
@@ -0,0 +1,73 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <projgeom/ell_object.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/parallel.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/verify.hpp>
+
+namespace {
+
+// Fails whenever the first entry is at least 5.
+struct ThresholdTheorem {
+  using T = int64_t;
+  static constexpr std::size_t size = 3;
+  using Config = std::array<T, size>;
+  static constexpr const char *name = "threshold";
+  static auto valid(const Config &) -> bool { return true; }
+  static auto check(const Config &c) -> bool { return c[0] < 5; }
+};
+
+} // namespace
+
+TEST_CASE("parallel_for visits every index once") {
+  std::vector<std::atomic<int>> hits(10007);
+  fun::parallel_for(
+      hits.size(),
+      [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i != end; ++i) {
+          ++hits[i];
+        }
+      },
+      13, 4);
+  auto ok = true;
+  for (const auto &h : hits) {
+    ok = ok && h == 1;
+  }
+  CHECK(ok);
+}
+
+TEST_CASE("randomized theorem verification") {
+#if PROJGEOM_HAS_INT128
+  const auto pappus =
+      fun::verify<fun::PappusTheorem<BasicEllPoint<__int128>>>(2000, 1, 16);
+  CHECK(pappus.checked + pappus.skipped == 2000);
+  CHECK(pappus.failures == 0);
+  CHECK(!pappus.counterexample);
+
+  const auto desargue =
+      fun::verify<fun::DesargueTheorem<BasicHypPoint<__int128>>>(2000, 2);
+  CHECK(desargue.failures == 0);
+#endif
+
+  const auto axiom = fun::verify<fun::AxiomTheorem<PgPoint>>(2000, 3);
+  CHECK(axiom.failures == 0);
+  CHECK(axiom.configs_per_second() > 0.0);
+}
+
+TEST_CASE("counterexamples are shrunk") {
+  const auto report = fun::verify<ThresholdTheorem>(100, 4, 100, 2);
+  REQUIRE(report.failures != 0);
+  REQUIRE(report.counterexample);
+  CHECK(*report.counterexample == std::array<int64_t, 3>{5, 0, 0});
+
+  // the configurations do not depend on the thread count
+  const auto serial = fun::verify<ThresholdTheorem>(100, 4, 100, 1);
+  CHECK(serial.failures == report.failures);
+  CHECK(serial.counterexample == report.counterexample);
+}
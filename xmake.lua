@@ -1,9 +1,10 @@
-set_languages("c++11")
+set_languages("c++20")
 
 add_rules("mode.debug", "mode.release", "mode.coverage")
 add_requires("fmt", {alias = "fmt"})
 add_requires("doctest", {alias = "doctest"})
 add_requires("range-v3", {alias = "range-v3"})
+add_requires("benchmark", {alias = "benchmark"})
 
 if is_mode("coverage") then
     add_cxflags("-ftest-coverage", "-fprofile-arcs", {force = true})
@@ -26,11 +27,27 @@ target("test_projgeom")
     add_files("tests/*.cpp")
     if is_plat("linux") then
         -- add_cxflags("-fconcepts", {force = true})
+        add_syslinks("pthread")
     elseif is_plat("windows") then
         add_cxflags("/W4 /WX /wd4819", {force = true})
     end
     add_packages("fmt", "doctest", "range-v3")
 
+target("bench_adaptive")
+    set_kind("binary")
+    add_includedirs("include", {public = true})
+    add_files("bench/bench_adaptive.cpp")
+    add_packages("benchmark", "range-v3")
+
+-- micro (per primitive) and macro (per theorem check) benchmarks;
+-- `xmake run bench_projgeom` writes the results to bench_projgeom.json
+target("bench_projgeom")
+    set_kind("binary")
+    add_includedirs("include", {public = true})
+    add_files("bench/bench_projgeom.cpp")
+    add_packages("benchmark", "range-v3")
+    set_runargs("--benchmark_out=bench_projgeom.json", "--benchmark_out_format=json")
+
 --
 -- If you want to known more usage about xmake, please see https://xmake.io
 --